@@ -6,10 +6,11 @@
 namespace algorithm {
 
 
-template <typename Tp, typename Fn>
-auto find_indices(Tp const& container, Fn& predicate) -> std::vector<std::size_t>
+// Fills results with the indices that match, reusing its storage.
+template <typename Tp, typename Fn, typename Out>
+void find_indices(Tp const& container, Fn& predicate, Out& results)
 {
-    std::vector<std::size_t> results;
+    results.clear();
 
     auto it = std::find_if(std::begin(container), std::end(container), predicate);
     while (it != std::end(container))
@@ -17,6 +18,13 @@ auto find_indices(Tp const& container, Fn& predicate) -> std::vector<std::size_t
         results.emplace_back(std::distance(std::begin(container), it));
         it = std::find_if(std::next(it), std::end(container), predicate);
     }
+}
+
+template <typename Tp, typename Fn>
+auto find_indices(Tp const& container, Fn& predicate) -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> results;
+    find_indices(container, predicate, results);
     return results;
 }
 
@@ -0,0 +1,122 @@
+#pragma once
+#include "typedefs.h"
+#include <vector>
+
+namespace animation {
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class Direction : int8 {
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Picks the direction a sprite faces from its velocity (world coordinates, y
+// up). Equivalent to splitting atan2(-vy, vx) into 90 degree segments centered
+// on the axes, but only compares magnitudes and signs. Diagonals resolve the
+// same way the segments did, i.e. to the direction clockwise of them.
+constexpr auto select_direction(float vx, float vy) -> Direction
+{
+    float const ax = (vx < 0) ? -vx : vx;
+    float const ay = (vy < 0) ? -vy : vy;
+
+    if (ay > ax)
+    {
+        return (vy < 0) ? Direction::DOWN : Direction::UP;
+    }
+    if (ax > ay)
+    {
+        return (vx < 0) ? Direction::LEFT : Direction::RIGHT;
+    }
+
+    // Exactly diagonal.
+    if (vy < 0)
+    {
+        return (vx > 0) ? Direction::DOWN : Direction::LEFT;
+    }
+    return (vx < 0) ? Direction::UP : Direction::RIGHT;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Frame accumulators are 16.16 fixed point, one frame is FRAME_ONE.
+constexpr int32 FRAME_ONE = 1 << 16;
+
+// Fast moving sprites advance a frame every 30 updates, slow ones wind back.
+constexpr int32 FRAME_STEP = (FRAME_ONE + 29) / 30;
+
+// Speeds are compared squared to avoid the sqrt.
+constexpr float IDLE_SPEED_SQ = 20.f * 20.f;
+constexpr float FAST_SPEED_SQ = 50.f * 50.f;
+
+// Per entity animation state, stored as structure of arrays so every sprite is
+// updated in one pass. Callers write each entity's velocity into vx/vy before
+// calling animate.
+struct Animator {
+    std::vector<float>     vx;
+    std::vector<float>     vy;
+    std::vector<Direction> directions;
+    std::vector<int32>     accumulators;
+    std::vector<uint8>     frames;
+
+    auto size() const noexcept -> std::size_t { return directions.size(); }
+
+    auto add(Direction direction = Direction::RIGHT) -> std::size_t
+    {
+        vx.push_back(0.f);
+        vy.push_back(0.f);
+        directions.push_back(direction);
+        accumulators.push_back(0);
+        frames.push_back(0);
+        return directions.size() - 1;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline void animate(Animator& animator, int frame_count)
+{
+    std::size_t const n = animator.size();
+
+    float const* vx           = animator.vx.data();
+    float const* vy           = animator.vy.data();
+    Direction*   directions   = animator.directions.data();
+    int32*       accumulators = animator.accumulators.data();
+    uint8*       frames       = animator.frames.data();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        float const speed_sq = (vx[i] * vx[i]) + (vy[i] * vy[i]);
+
+        if (speed_sq < IDLE_SPEED_SQ)
+        {
+            // Leave the direction as it is to leave the sprite facing in the
+            // direction of travel as it stops.
+            frames[i] = 0;
+            continue;
+        }
+
+        directions[i] = select_direction(vx[i], vy[i]);
+
+        int32 acc = accumulators[i] + ((speed_sq > FAST_SPEED_SQ) ? FRAME_STEP : -FRAME_STEP);
+        acc       = (acc < 0) ? 0 : acc;
+
+        // Starts again from zero rather than carrying the remainder, 30 steps
+        // overshoot FRAME_ONE a little and the carry would add up.
+        if (acc >= FRAME_ONE)
+        {
+            acc       = 0;
+            frames[i] = (frames[i] + 1 >= frame_count) ? 0 : frames[i] + 1;
+        }
+
+        accumulators[i] = acc;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
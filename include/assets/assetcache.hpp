@@ -0,0 +1,192 @@
+#pragma once
+
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace assets {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Decoded pixels, already in the renderer's native pixel format.
+struct Image {
+    int                w;
+    int                h;
+    int                pitch;
+    uint32             format;
+    std::vector<uint8> pixels;
+};
+
+// Decodes the bytes of an image file into format. name is only for errors.
+using Decoder = auto (*)(std::vector<char> const& bytes, uint32 format, char const* name)
+    -> std::shared_ptr<Image const>;
+
+// Decodes with SDL_image. Returns null on failure.
+auto decode_image(std::vector<char> const& bytes, uint32 format, char const* name)
+    -> std::shared_ptr<Image const>;
+
+class AssetCache;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Shared owner of an image in an AssetCache. Copies share the image; its
+// pixels and texture are freed when the last copy is destroyed. The cache must
+// outlive every handle made from it.
+class ImageHandle {
+public:
+    ImageHandle() = default;
+
+    // Dtor
+    ~ImageHandle();
+
+    // Copy
+    ImageHandle(ImageHandle const& other);
+    auto operator=(ImageHandle const& other) -> ImageHandle&;
+
+    // Move
+    ImageHandle(ImageHandle&& other) noexcept;
+    auto operator=(ImageHandle&& other) noexcept -> ImageHandle&;
+
+    explicit operator bool() const noexcept { return cache != nullptr; }
+
+    auto index() const noexcept -> std::size_t { return slot; }
+
+private:
+    friend class AssetCache;
+
+    // Adopts a reference the cache has already counted.
+    ImageHandle(AssetCache& cache, std::size_t index) noexcept;
+
+    void release() noexcept;
+
+private:
+    AssetCache* cache{};
+    std::size_t slot{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Loads images from the resource directory.
+//
+// - Requests are deduplicated by path, and by content so identical files
+//   share one decoded copy. A matching content hash is only a candidate, the
+//   files' bytes are compared before they share.
+// - Decoding happens on a worker thread, straight into the renderer's native
+//   pixel format so uploading is a copy.
+// - Decoded pixels are written to cache_dir, keyed by the file's path, size
+//   and modification time, and read back on later launches without reading
+//   or decoding the file. An edit that keeps both the size and the
+//   modification time is not noticed.
+// - Textures are created and destroyed on the render thread. Handles can be
+//   released on any thread, their textures wait for destroy_released().
+class AssetCache {
+public:
+    AssetCache(std::filesystem::path res_dir,
+               std::filesystem::path cache_dir,
+               uint32                pixel_format,
+               Decoder               decoder = decode_image);
+
+    // Must be destroyed on the render thread.
+    ~AssetCache();
+
+    AssetCache(AssetCache const&) = delete;
+    auto operator=(AssetCache const&) -> AssetCache& = delete;
+
+    // Queues file_name (relative to the resource directory) for decoding.
+    auto request(std::string const& file_name) -> ImageHandle;
+
+    // Blocks until the image has been decoded, or failed to. Returns null on
+    // failure.
+    auto wait(ImageHandle const& handle) -> Image const*;
+
+    // Returns null if the image is not decoded yet or failed to decode.
+    auto image(ImageHandle const& handle) -> Image const*;
+
+    // Uploads the image on first use. Must be called on the render thread.
+    auto texture(ImageHandle const& handle, SDL_Renderer* renderer) -> SDL_Texture*;
+
+    // Destroys the textures of images released since the last call. Must be
+    // called on the render thread, e.g. once a frame.
+    void destroy_released();
+
+    auto pixel_format() const noexcept -> uint32 { return format; }
+
+private:
+    friend class ImageHandle;
+
+    enum class State {
+        QUEUED,
+        READY,
+        FAILED
+    };
+
+    struct Entry {
+        std::filesystem::path        path;
+        State                        state{State::QUEUED};
+        int                          ref_count{};
+        std::shared_ptr<Image const> image;
+        SDL_Texture*                 texture{};
+    };
+
+    void acquire(std::size_t index);
+    void release(std::size_t index);
+
+    // A decoded file, found by its content hash.
+    struct Content {
+        std::filesystem::path      path;
+        uint64                     size{};
+        std::weak_ptr<Image const> image;
+    };
+
+    void worker_loop();
+    auto decode(std::filesystem::path const& path) -> std::shared_ptr<Image const>;
+    auto find_duplicate(uint64                       content_hash,
+                        std::filesystem::path const& path,
+                        uint64                       size,
+                        std::vector<char>&           bytes) -> std::shared_ptr<Image const>;
+
+private:
+    std::filesystem::path res_dir;
+    std::filesystem::path cache_dir;
+    uint32                format;
+    Decoder               decoder;
+
+    // Guards everything below, shared with the worker.
+    std::mutex              mutex;
+    std::condition_variable queued;
+    std::condition_variable decoded;
+
+    // Entries are never erased, only emptied, so indices stay valid for
+    // handles and the worker. Freed entries are reused.
+    std::vector<Entry>                           entries;
+    std::vector<std::size_t>                     free_entries;
+    std::unordered_map<std::string, std::size_t> by_path;
+    std::unordered_map<uint64, Content>          by_content;
+    std::vector<SDL_Texture*>                    released_textures;
+    std::deque<std::size_t>                      jobs;
+    bool                                         stopping{};
+
+    std::thread worker;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Walks up from start looking for the game's res directory, so the game runs
+// from the build directory or an install without hard-coded paths.
+auto find_resource_dir(std::filesystem::path const& start) -> std::optional<std::filesystem::path>;
+
+// The renderer's preferred texture format.
+auto native_pixel_format(SDL_Renderer* renderer) -> uint32;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
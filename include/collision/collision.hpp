@@ -1,11 +1,25 @@
 #pragma once
+#include "debug/counters.hpp"
 #include "linalg/matrix.hpp"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
 
 namespace collision {
 
+// Sub-steps to move at speed for dt without any one covering more than
+// max_distance, so a mover cannot step over a thin boundary. At least one and
+// at most max_steps, past which a mover is allowed to tunnel.
+inline auto substep_count(float speed, float dt, float max_distance, int max_steps) -> int
+{
+    int const steps = static_cast<int>(std::ceil((speed * dt) / max_distance));
+    return std::clamp(steps, 1, max_steps);
+}
+
 inline auto is_point_in_rect(float x, float y, SDL_FRect const& rect)
 {
+    debug::count(debug::Counter::POINT_IN_RECT);
+
     bool in_x = (x > rect.x) && (x < (rect.x + rect.w));
     bool in_y = (y > rect.y) && (y < (rect.y + rect.h));
 
@@ -15,6 +29,8 @@ inline auto is_point_in_rect(float x, float y, SDL_FRect const& rect)
 
 inline auto is_point_in_rect(float x, float y, SDL_Rect const& rect)
 {
+    debug::count(debug::Counter::POINT_IN_RECT);
+
     bool in_x = (x > rect.x) && (x < (rect.x + rect.w));
     bool in_y = (y > rect.y) && (y < (rect.y + rect.h));
 
@@ -24,6 +40,8 @@ inline auto is_point_in_rect(float x, float y, SDL_Rect const& rect)
 
 inline auto is_point_in_rect(linalg::Vectorf<2> v, SDL_FRect const& rect)
 {
+    debug::count(debug::Counter::POINT_IN_RECT);
+
     int x = v[0];
     int y = v[1];
 
@@ -36,6 +54,8 @@ inline auto is_point_in_rect(linalg::Vectorf<2> v, SDL_FRect const& rect)
 
 inline auto is_point_in_rect(linalg::Vectorf<2> v, SDL_Rect const& rect)
 {
+    debug::count(debug::Counter::POINT_IN_RECT);
+
     int x = v[0];
     int y = v[1];
 
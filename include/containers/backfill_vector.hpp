@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -165,7 +167,9 @@ struct backfill_vector {
         last -= 1;
     }
 
-    void remove(std::vector<std::size_t> idx)
+    // Removes every listed position, duplicates and out of range positions
+    // are ignored. Reorders idx rather than copying it.
+    void remove(std::span<std::size_t> idx)
     {
         // a is the current value to look at.
         // pivot is the position after partitioning using the value of a.
@@ -224,6 +228,11 @@ struct backfill_vector {
         last = back + 1;
     }
 
+    void remove(std::vector<std::size_t>&& idx)
+    {
+        remove(std::span<std::size_t>(idx));
+    }
+
 private:
     std::array<_Tp, _Nm> vector;
     std::size_t          last{};
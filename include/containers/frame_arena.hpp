@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+// frame_arena hands out memory for one unit of work, e.g. a sim tick, from a
+// buffer allocated once. Allocating bumps a pointer, deallocating does
+// nothing, and reset() frees everything at once.
+//
+// - Use it through std::pmr containers, e.g. std::pmr::vector<T> v(&arena),
+//   and let go of them before reset().
+// - If the buffer runs out, allocations go to upstream instead and are
+//   counted as overflows, so a too small arena is slower rather than wrong.
+// - high_water_mark() is the most any one unit has used, to size it by.
+class frame_arena : public std::pmr::memory_resource {
+public:
+    typedef std::size_t size_type;
+
+    explicit frame_arena(size_type capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : buffer(std::make_unique<std::byte[]>(capacity))
+        , capacity_(capacity)
+        , upstream(upstream)
+    {
+    }
+
+    frame_arena(frame_arena const&) = delete;
+    frame_arena& operator=(frame_arena const&) = delete;
+
+    // Frees everything allocated since the last reset.
+    void reset() noexcept
+    {
+        high_water = std::max(high_water, used_);
+        used_      = 0;
+    }
+
+    // Bytes used since the last reset, alignment padding included.
+    size_type used() const noexcept { return used_; }
+    size_type capacity() const noexcept { return capacity_; }
+    size_type high_water_mark() const noexcept { return std::max(high_water, used_); }
+
+    // Allocations that did not fit and went upstream.
+    size_type overflows() const noexcept { return overflow_count; }
+
+private:
+    void* do_allocate(size_type bytes, size_type alignment) override
+    {
+        // At least a byte, so every pointer handed out is inside the buffer.
+        auto const base    = reinterpret_cast<std::uintptr_t>(buffer.get());
+        auto const aligned = (base + used_ + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        auto const end     = (aligned - base) + std::max(bytes, size_type{1});
+
+        if (end > capacity_)
+        {
+            ++overflow_count;
+            return upstream->allocate(bytes, alignment);
+        }
+
+        used_ = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void do_deallocate(void* p, size_type bytes, size_type alignment) override
+    {
+        // Only the overflows are freed one at a time.
+        if (!owns(p))
+        {
+            upstream->deallocate(p, bytes, alignment);
+        }
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    bool owns(void const* p) const noexcept
+    {
+        auto const base    = reinterpret_cast<std::uintptr_t>(buffer.get());
+        auto const address = reinterpret_cast<std::uintptr_t>(p);
+        return (address >= base) && (address < base + capacity_);
+    }
+
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    size_type                    capacity_;
+    size_type                    used_{};
+    size_type                    high_water{};
+    size_type                    overflow_count{};
+    std::pmr::memory_resource*   upstream;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// slot_map stores values in reusable slots addressed by generational handles.
+//
+// - insert reuses a released slot before growing, so creating and destroying
+//   values every tick does not grow the storage.
+// - Handles are an index and a generation rather than a pointer, so they stay
+//   valid when the storage reallocates.
+// - Erasing a value bumps the slot's generation, so stale handles are detected
+//   instead of silently reading whatever reused the slot.
+template <typename _Tp>
+struct slot_map {
+    typedef _Tp               value_type;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef std::size_t       size_type;
+
+    struct handle {
+        std::uint32_t index{~std::uint32_t{0}};
+        std::uint32_t generation{};
+
+        friend bool operator==(handle const&, handle const&) = default;
+    };
+
+    // Capacity.
+    size_type size() const noexcept { return live; }
+
+    size_type capacity() const noexcept { return slots.size(); }
+
+    [[nodiscard]] bool
+    empty() const noexcept { return live == 0; }
+
+    void reserve(size_type n)
+    {
+        slots.reserve(n);
+        free_slots.reserve(n);
+    }
+
+    // Lookup.
+    bool contains(handle h) const noexcept
+    {
+        return (h.index < slots.size())
+               && slots[h.index].occupied
+               && (slots[h.index].generation == h.generation);
+    }
+
+    // Accessors.
+    reference at(handle h)
+    {
+        if (!contains(h))
+        {
+            throw std::out_of_range("Stale or invalid slot_map handle.");
+        }
+        return slots[h.index].value;
+    }
+
+    const_reference at(handle h) const
+    {
+        if (!contains(h))
+        {
+            throw std::out_of_range("Stale or invalid slot_map handle.");
+        }
+        return slots[h.index].value;
+    }
+
+    // Unchecked access by slot index, for owners that guarantee the slot is
+    // live, e.g. a timer payload that is cancelled when the slot is erased.
+    reference at_index(std::uint32_t index) noexcept
+    {
+        assert(index < slots.size() && slots[index].occupied);
+        return slots[index].value;
+    }
+
+    // Visits every live value.
+    template <typename Fn>
+    void for_each(Fn&& fn)
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.occupied)
+            {
+                fn(slot.value);
+            }
+        }
+    }
+
+    // Modifiers.
+    handle insert(value_type value)
+    {
+        std::uint32_t index;
+        if (free_slots.empty())
+        {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({});
+        }
+        else
+        {
+            index = free_slots.back();
+            free_slots.pop_back();
+        }
+
+        auto& slot    = slots[index];
+        slot.value    = std::move(value);
+        slot.occupied = true;
+        live += 1;
+
+        return {index, slot.generation};
+    }
+
+    bool erase(handle h) noexcept
+    {
+        if (!contains(h))
+        {
+            return false;
+        }
+
+        auto& slot    = slots[h.index];
+        slot.value    = value_type{};
+        slot.occupied = false;
+        slot.generation += 1;
+        free_slots.push_back(h.index);
+        live -= 1;
+
+        return true;
+    }
+
+private:
+    struct slot {
+        value_type    value{};
+        std::uint32_t generation{};
+        bool          occupied{};
+    };
+
+    std::vector<slot>          slots;
+    std::vector<std::uint32_t> free_slots;
+    size_type                  live{};
+};
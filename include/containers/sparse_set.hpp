@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// sparse_set maps externally owned ids onto a packed (dense) array.
+//
+// - insert, erase and contains are O(1).
+// - Iteration only touches the dense arrays, which are always packed.
+// - Each id owns one row made of several columns, e.g. an entity and the
+//   boundaries cached for it. Erasing an id moves the last row into the hole,
+//   for every column at once, so the columns never fall out of step.
+//
+// Note that erase changes the dense position of the last row. Hold on to ids,
+// not dense positions.
+//
+// version() changes whenever rows are inserted or erased, so caches built from
+// the set (e.g. a pre-rendered layer) can tell when they are stale. Edits made
+// through column() or get() are not seen; call touch() after them.
+template <typename... _Cols>
+struct sparse_set {
+    static_assert(sizeof...(_Cols) > 0, "sparse_set requires at least one column.");
+
+    typedef std::uint32_t id_type;
+    typedef std::size_t   size_type;
+
+    static constexpr id_type npos = ~id_type{0};
+
+    // Iterators - over the ids in dense order.
+    auto begin() const noexcept { return ids.cbegin(); }
+    auto end() const noexcept { return ids.cend(); }
+
+    // Capacity.
+    size_type size() const noexcept { return ids.size(); }
+
+    [[nodiscard]] bool
+    empty() const noexcept { return ids.empty(); }
+
+    void reserve(size_type n)
+    {
+        ids.reserve(n);
+        std::apply([n](auto&... col) { (col.reserve(n), ...); }, columns);
+    }
+
+    std::uint32_t version() const noexcept { return revision; }
+
+    void touch() noexcept { ++revision; }
+
+    // Lookup.
+    bool contains(id_type id) const noexcept
+    {
+        return (id < sparse.size()) && (sparse[id] != npos);
+    }
+
+    size_type index_of(id_type id) const
+    {
+        if (!contains(id))
+        {
+            throw std::out_of_range("Id is not in sparse_set.");
+        }
+        return sparse[id];
+    }
+
+    id_type id_at(size_type pos) const
+    {
+        return ids.at(pos);
+    }
+
+    // Accessors.
+    //
+    // column<I>() is the packed array for the Ith column and is index aligned
+    // with every other column and with the ids.
+    template <std::size_t I>
+    auto& column() noexcept
+    {
+        return std::get<I>(columns);
+    }
+
+    template <std::size_t I>
+    auto const& column() const noexcept
+    {
+        return std::get<I>(columns);
+    }
+
+    template <std::size_t I>
+    auto& get(id_type id)
+    {
+        return column<I>()[index_of(id)];
+    }
+
+    template <std::size_t I>
+    auto const& get(id_type id) const
+    {
+        return column<I>()[index_of(id)];
+    }
+
+    // Modifiers.
+    void insert(id_type id, _Cols... values) noexcept(false)
+    {
+        if (id == npos)
+        {
+            throw std::out_of_range("Id is reserved by sparse_set.");
+        }
+        if (contains(id))
+        {
+            throw std::invalid_argument("Id is already in sparse_set.");
+        }
+        if (id >= sparse.size())
+        {
+            sparse.resize(id + 1, npos);
+        }
+
+        sparse[id] = static_cast<id_type>(ids.size());
+        ids.push_back(id);
+        push_back(std::index_sequence_for<_Cols...>{}, std::move(values)...);
+        ++revision;
+    }
+
+    bool erase(id_type id) noexcept
+    {
+        if (!contains(id))
+        {
+            return false;
+        }
+
+        auto const pos  = sparse[id];
+        auto const back = static_cast<id_type>(ids.size() - 1);
+
+        if (pos != back)
+        {
+            auto const moved = ids[back];
+
+            ids[pos]      = moved;
+            sparse[moved] = pos;
+            std::apply([pos, back](auto&... col) { ((col[pos] = std::move(col[back])), ...); }, columns);
+        }
+
+        ids.pop_back();
+        std::apply([](auto&... col) { (col.pop_back(), ...); }, columns);
+        sparse[id] = npos;
+        ++revision;
+
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        for (auto id : ids)
+        {
+            sparse[id] = npos;
+        }
+        ids.clear();
+        std::apply([](auto&... col) { (col.clear(), ...); }, columns);
+        ++revision;
+    }
+
+private:
+    template <std::size_t... Is>
+    void push_back(std::index_sequence<Is...>, _Cols&&... values)
+    {
+        (std::get<Is>(columns).push_back(std::move(values)), ...);
+    }
+
+private:
+    std::vector<id_type>              sparse;
+    std::vector<id_type>              ids;
+    std::tuple<std::vector<_Cols>...> columns;
+    std::uint32_t                     revision{};
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// spsc_ring is a fixed size queue from one producer thread to one consumer
+// thread, without locks or waiting.
+//
+// - The producer calls push(). It returns false, dropping the value, when the
+//   ring is full.
+// - The consumer looks at the oldest value with front() and removes it with
+//   pop(), so it can leave a value queued after looking at it.
+//
+// Positions count up forever and are masked into the slots, so _Capacity must
+// be a power of two and every slot is usable.
+template <typename _Tp, std::size_t _Capacity>
+struct spsc_ring {
+    static_assert((_Capacity > 0) && ((_Capacity & (_Capacity - 1)) == 0),
+                  "spsc_ring capacity must be a power of two");
+
+    typedef _Tp         value_type;
+    typedef std::size_t size_type;
+
+    spsc_ring() = default;
+
+    spsc_ring(spsc_ring const&) = delete;
+    spsc_ring& operator=(spsc_ring const&) = delete;
+
+    // Producer.
+    bool push(value_type const& value) noexcept
+    {
+        size_type const tail = write.load(std::memory_order_relaxed);
+        if ((tail - read_cache) == _Capacity)
+        {
+            read_cache = read.load(std::memory_order_acquire);
+            if ((tail - read_cache) == _Capacity)
+            {
+                return false;
+            }
+        }
+
+        slots[tail & MASK] = value;
+        write.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer. nullptr when empty.
+    value_type const* front() noexcept
+    {
+        size_type const head = read.load(std::memory_order_relaxed);
+        if (head == write_cache)
+        {
+            write_cache = write.load(std::memory_order_acquire);
+            if (head == write_cache)
+            {
+                return nullptr;
+            }
+        }
+
+        return &slots[head & MASK];
+    }
+
+    // Consumer. Only after front() returned a value.
+    void pop() noexcept
+    {
+        read.store(read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    static constexpr size_type capacity() noexcept { return _Capacity; }
+
+private:
+    static constexpr size_type MASK = _Capacity - 1;
+
+    std::array<value_type, _Capacity> slots{};
+
+    // Each side's position, and its cached copy of the other side's, on its
+    // own cache line.
+    alignas(64) std::atomic<size_type> write{0};
+    size_type read_cache{0};
+    alignas(64) std::atomic<size_type> read{0};
+    size_type write_cache{0};
+};
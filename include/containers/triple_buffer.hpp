@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// triple_buffer hands values from one writer thread to one reader thread
+// without locks or waiting.
+//
+// - The writer fills write_buffer() and calls publish(). It never blocks,
+//   however slow the reader is.
+// - The reader calls update() to take the most recently published value,
+//   then reads it through read_buffer(). Values published in between are
+//   skipped, the reader only ever sees the latest.
+// - Each side owns one of the three slots outright, the third is swapped
+//   between them with one atomic exchange. A slot is never touched by both
+//   threads at once.
+//
+// A slot handed back to the writer still holds an old value, so the writer
+// must overwrite everything it publishes. Reusing a slot's storage (e.g.
+// clearing and refilling vectors) is fine and avoids allocating.
+template <typename _Tp>
+struct triple_buffer {
+    typedef _Tp value_type;
+
+    triple_buffer() = default;
+
+    // Starts every slot as a copy of value, so the reader has something to
+    // read before the first publish.
+    explicit triple_buffer(value_type const& value)
+        : slots{value, value, value}
+    {
+    }
+
+    triple_buffer(triple_buffer const&) = delete;
+    triple_buffer& operator=(triple_buffer const&) = delete;
+
+    // Writer.
+    value_type& write_buffer() noexcept { return slots[back]; }
+
+    void publish() noexcept
+    {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader. Returns true if a value was published since the last update.
+    bool update() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+        {
+            return false;
+        }
+
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    value_type const& read_buffer() const noexcept { return slots[front]; }
+
+    value_type& read_buffer() noexcept { return slots[front]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    std::array<value_type, 3> slots{};
+
+    // Each side's index on its own cache line.
+    alignas(64) std::uint8_t back{0};
+    alignas(64) std::uint8_t front{1};
+    alignas(64) std::atomic<std::uint8_t> middle{2};
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "debug/counters.hpp"
+#include "typedefs.h"
+#include <cstddef>
+#include <new>
+#include <stdio.h>
+
+// Heap allocation counts, per thread. src/debug/allocations.cpp replaces the
+// global operator new to count every allocation on the thread that made it,
+// executables that do not link it count nothing, see allocations_counted().
+//
+// Only operator new is seen. malloc from C code, e.g. SDL or stdio, is not.
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Allocations {
+    uint64 count{};
+    uint64 bytes{};
+};
+
+// Everything the calling thread has allocated, never reset.
+inline auto thread_allocations() -> Allocations&
+{
+    static thread_local Allocations allocations;
+    return allocations;
+}
+
+// Called by the operator new hook.
+inline void note_allocation(std::size_t bytes)
+{
+    auto& allocations = thread_allocations();
+    allocations.count += 1;
+    allocations.bytes += bytes;
+
+    count(Counter::ALLOCATIONS);
+    count(Counter::ALLOCATED_BYTES, bytes);
+}
+
+inline auto allocations_since(Allocations const& start) -> Allocations
+{
+    auto const& now = thread_allocations();
+    return {now.count - start.count, now.bytes - start.bytes};
+}
+
+// True if the hook is linked in. Calls operator new directly, a new
+// expression may be optimised away.
+inline auto allocations_counted() -> bool
+{
+    uint64 const before = thread_allocations().count;
+
+    void* p = ::operator new(1);
+    ::operator delete(p);
+
+    return thread_allocations().count != before;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that ticks stop allocating once warmed up. Containers grow to their
+// working size over the first ticks, after that any allocation is a hitch
+// waiting to happen. Call begin() and end() around each tick on the thread
+// that runs it.
+class TickAllocationCheck {
+public:
+    static constexpr uint64 WARM_UP    = 120; // Ticks, two seconds.
+    static constexpr uint64 MAX_REPORT = 10;  // Ticks printed before going quiet.
+
+    explicit TickAllocationCheck(uint64 warm_up = WARM_UP)
+        : warm_up(warm_up)
+    {
+    }
+
+    void begin() { start = thread_allocations(); }
+
+    // Returns false, and prints the first few, if the tick allocated after
+    // the warm up.
+    auto end(uint64 tick) -> bool
+    {
+        auto const allocated = allocations_since(start);
+        if ((++ticks <= warm_up) || (allocated.count == 0))
+        {
+            return true;
+        }
+
+        if (++offenders <= MAX_REPORT)
+        {
+            printf("Tick %llu allocated %llu times, %llu bytes.\n",
+                   static_cast<unsigned long long>(tick),
+                   static_cast<unsigned long long>(allocated.count),
+                   static_cast<unsigned long long>(allocated.bytes));
+        }
+        return false;
+    }
+
+    // Ticks after the warm up that allocated.
+    auto allocating_ticks() const noexcept -> uint64 { return offenders; }
+
+private:
+    uint64      warm_up;
+    uint64      ticks{};
+    uint64      offenders{};
+    Allocations start;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
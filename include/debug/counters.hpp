@@ -0,0 +1,234 @@
+#pragma once
+
+#include "containers/spsc_ring.hpp"
+#include "typedefs.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+
+// Hot path counters. debug::count(Counter::X) adds to the calling thread's
+// own counts, no atomics or locks. A thread takes its counts at the end of
+// each unit of work, a tick on the sim thread and a frame on the main
+// thread, and hands them to a TelemetryWriter as one row.
+//
+// Define DISABLE_COUNTERS to compile every count out.
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class Counter : uint8 {
+    POINT_IN_RECT,        // collision::is_point_in_rect calls.
+    COLLISION_CANDIDATES, // Pairs tested by the narrow phase, there is no broad phase.
+    COLLISION_HITS,       // Pairs that collided.
+    LIVE_BULLETS,         // Summed over ticks.
+    SIM_TICKS,            // Sim ticks a frame shows.
+    DRAW_CALLS,
+    UPDATE_BYTES,    // Copied by entity::update.
+    ALLOCATIONS,     // operator new calls, see debug/allocations.hpp.
+    ALLOCATED_BYTES, // Asked of operator new.
+    SCRATCH_BYTES,   // Used of World::scratch, summed over ticks.
+    COUNT,
+};
+
+constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::COUNT);
+
+constexpr std::array<char const*, COUNTER_COUNT> COUNTER_NAMES{
+    "point_in_rect",
+    "collision_candidates",
+    "collision_hits",
+    "live_bullets",
+    "sim_ticks",
+    "draw_calls",
+    "update_bytes",
+    "allocations",
+    "allocated_bytes",
+    "scratch_bytes",
+};
+
+struct Counters {
+    std::array<uint64, COUNTER_COUNT> values{};
+
+    auto operator[](Counter counter) -> uint64& { return values[static_cast<std::size_t>(counter)]; }
+    auto operator[](Counter counter) const -> uint64 { return values[static_cast<std::size_t>(counter)]; }
+};
+
+// The calling thread's counts since it last took them.
+inline auto thread_counters() -> Counters&
+{
+    static thread_local Counters counters;
+    return counters;
+}
+
+#ifdef DISABLE_COUNTERS
+inline void count(Counter, uint64 = 1) {}
+#else
+inline void count(Counter counter, uint64 amount = 1) { thread_counters()[counter] += amount; }
+#endif // DISABLE_COUNTERS
+
+// Returns the calling thread's counts and starts them again from zero.
+inline auto take_counters() -> Counters
+{
+    Counters taken    = thread_counters();
+    thread_counters() = {};
+    return taken;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Nanoseconds on the steady clock.
+inline auto counter_time() -> uint64
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct CounterRow {
+    char     kind;  // 't' for a sim tick, 'f' for a frame.
+    uint64   index; // Tick or frame number.
+    uint64   time;  // When it ended, see counter_time().
+    Counters counters;
+};
+
+// Collects counter rows on the main thread, keeps the most recent RECENT of
+// them and, once open() is called, streams every row to a CSV file:
+//
+//   kind,index,time_ms,point_in_rect,...
+//
+// time_ms is from when the writer was made. Another thread, e.g. the sim
+// thread, hands its rows over with push() and they are collected on the next
+// flush().
+class TelemetryWriter {
+public:
+    static constexpr std::size_t RECENT = 1024;
+
+    TelemetryWriter()
+        : origin(counter_time())
+    {
+    }
+
+    ~TelemetryWriter() { close(); }
+
+    TelemetryWriter(TelemetryWriter const&) = delete;
+    TelemetryWriter& operator=(TelemetryWriter const&) = delete;
+
+    // Returns false, and stays closed, if the file could not be opened.
+    auto open(char const* path) -> bool
+    {
+        close();
+
+        file = open_csv(path);
+        return file != nullptr;
+    }
+
+    void close()
+    {
+        if (file != nullptr)
+        {
+            flush();
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    auto is_open() const noexcept -> bool { return file != nullptr; }
+
+    // The other thread. Dropped if the main thread has fallen far behind.
+    void push(CounterRow const& row)
+    {
+        if (!pending.push(row))
+        {
+            dropped_rows.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Main thread.
+    void write(CounterRow const& row)
+    {
+        recent[recent_next] = row;
+        recent_next         = (recent_next + 1) % RECENT;
+        recent_size         = (recent_size < RECENT) ? recent_size + 1 : RECENT;
+
+        if (file != nullptr)
+        {
+            write_csv(file, row);
+        }
+    }
+
+    // Main thread. Collects the rows pushed since the last flush.
+    void flush()
+    {
+        while (CounterRow const* row = pending.front())
+        {
+            write(*row);
+            pending.pop();
+        }
+    }
+
+    // Main thread. Writes the most recent rows, oldest first, to a CSV file
+    // of their own. Returns false if it could not be written.
+    auto write_recent(char const* path) const -> bool
+    {
+        FILE* out = open_csv(path);
+        if (out == nullptr)
+        {
+            return false;
+        }
+
+        std::size_t const first = (recent_next + RECENT - recent_size) % RECENT;
+        for (std::size_t i = 0; i < recent_size; ++i)
+        {
+            write_csv(out, recent[(first + i) % RECENT]);
+        }
+
+        bool const ok = (ferror(out) == 0);
+        fclose(out);
+        return ok;
+    }
+
+    auto dropped() const noexcept -> uint64 { return dropped_rows.load(std::memory_order_relaxed); }
+
+private:
+    static auto open_csv(char const* path) -> FILE*
+    {
+        FILE* out = fopen(path, "w");
+        if (out == nullptr)
+        {
+            printf("Could not open %s for telemetry.\n", path);
+            return nullptr;
+        }
+
+        fprintf(out, "kind,index,time_ms");
+        for (auto const* name : COUNTER_NAMES)
+        {
+            fprintf(out, ",%s", name);
+        }
+        fprintf(out, "\n");
+        return out;
+    }
+
+    void write_csv(FILE* out, CounterRow const& row) const
+    {
+        double const ms = (row.time >= origin) ? static_cast<double>(row.time - origin) / 1e6 : 0.0;
+
+        fprintf(out, "%c,%llu,%.3f", row.kind, static_cast<unsigned long long>(row.index), ms);
+        for (uint64 value : row.counters.values)
+        {
+            fprintf(out, ",%llu", static_cast<unsigned long long>(value));
+        }
+        fprintf(out, "\n");
+    }
+
+private:
+    uint64                         origin;
+    FILE*                          file{};
+    spsc_ring<CounterRow, 256>     pending;
+    std::atomic<uint64>            dropped_rows{0};
+    std::array<CounterRow, RECENT> recent{};
+    std::size_t                    recent_next{};
+    std::size_t                    recent_size{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
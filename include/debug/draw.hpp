@@ -0,0 +1,197 @@
+#pragma once
+
+#include "screen.h"
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <cmath>
+#include <vector>
+
+// Immediate mode debug drawing. Calls anywhere in a frame append lines to one
+// frame buffer, which submit() draws in a single SDL_RenderGeometry call and
+// empties. Coordinates are world coordinates, y up, like drawing::QuadBatch.
+//
+// Define DISABLE_DEBUG_DRAW to compile every call out. Otherwise calls return
+// straight away while set_enabled(false).
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr SDL_Color RED{0xff, 0x00, 0x00, 0xff};
+
+// Lines are quads one pixel wide, so any number of them in any colours is one
+// draw call.
+class LineBuffer {
+public:
+    bool enabled{true};
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+    }
+
+    void line(float x0, float y0, float x1, float y1, SDL_Color color = RED)
+    {
+        float const dx  = x1 - x0;
+        float const dy  = y1 - y0;
+        float const len = std::sqrt((dx * dx) + (dy * dy));
+        if (len <= 0.f)
+        {
+            return;
+        }
+
+        // Half a pixel either side of the line. Screen y is flipped, which
+        // flips the normal too but it is offset both ways so that is fine.
+        float const nx = (-dy / len) * 0.5f;
+        float const ny = (dx / len) * 0.5f;
+
+        int const base = static_cast<int>(vertices.size());
+
+        vertices.push_back(SDL_Vertex{{x0 + nx, to_screen_y(y0 + ny)}, color, {0.f, 0.f}});
+        vertices.push_back(SDL_Vertex{{x1 + nx, to_screen_y(y1 + ny)}, color, {0.f, 0.f}});
+        vertices.push_back(SDL_Vertex{{x1 - nx, to_screen_y(y1 - ny)}, color, {0.f, 0.f}});
+        vertices.push_back(SDL_Vertex{{x0 - nx, to_screen_y(y0 - ny)}, color, {0.f, 0.f}});
+
+        indices.push_back(base + 0);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base + 0);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    void rect(SDL_FRect const& r, SDL_Color color = RED)
+    {
+        float const x0 = r.x;
+        float const y0 = r.y;
+        float const x1 = r.x + r.w;
+        float const y1 = r.y + r.h;
+
+        line(x0, y0, x1, y0, color);
+        line(x1, y0, x1, y1, color);
+        line(x1, y1, x0, y1, color);
+        line(x0, y1, x0, y0, color);
+    }
+
+    // From (px, py) along (vx, vy), with a closed head at the end.
+    void arrow(float px, float py, float vx, float vy, SDL_Color color = RED)
+    {
+        float const len = std::sqrt((vx * vx) + (vy * vy));
+        if (len <= 0.f)
+        {
+            return;
+        }
+
+        float const tx = px + vx;
+        float const ty = py + vy;
+
+        // Head points are 10 back and 10 to either side of the tip.
+        float const ux = (vx / len) * 10.f;
+        float const uy = (vy / len) * 10.f;
+
+        float const lx = tx - ux - uy;
+        float const ly = ty - uy + ux;
+        float const rx = tx - ux + uy;
+        float const ry = ty - uy - ux;
+
+        line(px, py, tx, ty, color);
+        line(tx, ty, lx, ly, color);
+        line(lx, ly, rx, ry, color);
+        line(rx, ry, tx, ty, color);
+    }
+
+    void circle(float cx, float cy, float radius, SDL_Color color = RED, int segments = 24)
+    {
+        float const step = 6.2831853f / static_cast<float>(segments);
+
+        float x = cx + radius;
+        float y = cy;
+        for (int i = 1; i <= segments; ++i)
+        {
+            float const nx = cx + (radius * std::cos(step * i));
+            float const ny = cy + (radius * std::sin(step * i));
+
+            line(x, y, nx, ny, color);
+            x = nx;
+            y = ny;
+        }
+    }
+
+    // Draws every line added since the last submit and empties the buffer.
+    // Returns the number of draw calls made.
+    auto submit(SDL_Renderer* renderer) -> int;
+
+    auto line_count() const noexcept -> std::size_t { return vertices.size() / 4; }
+    auto vertex_list() const noexcept -> std::vector<SDL_Vertex> const& { return vertices; }
+    auto index_list() const noexcept -> std::vector<int> const& { return indices; }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int>        indices;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The buffer the free functions below draw into. Main thread only.
+inline auto frame() -> LineBuffer&
+{
+    static LineBuffer buffer;
+    return buffer;
+}
+
+#ifdef DISABLE_DEBUG_DRAW
+
+inline void set_enabled(bool) {}
+inline void line(float, float, float, float, SDL_Color = RED) {}
+inline void rect(SDL_FRect const&, SDL_Color = RED) {}
+inline void arrow(float, float, float, float, SDL_Color = RED) {}
+inline void circle(float, float, float, SDL_Color = RED, int = 24) {}
+inline auto submit(SDL_Renderer*) -> int { return 0; }
+
+#else
+
+inline void set_enabled(bool enabled) { frame().enabled = enabled; }
+
+inline void line(float x0, float y0, float x1, float y1, SDL_Color color = RED)
+{
+    if (frame().enabled)
+    {
+        frame().line(x0, y0, x1, y1, color);
+    }
+}
+
+inline void rect(SDL_FRect const& r, SDL_Color color = RED)
+{
+    if (frame().enabled)
+    {
+        frame().rect(r, color);
+    }
+}
+
+inline void arrow(float px, float py, float vx, float vy, SDL_Color color = RED)
+{
+    if (frame().enabled)
+    {
+        frame().arrow(px, py, vx, vy, color);
+    }
+}
+
+inline void circle(float cx, float cy, float radius, SDL_Color color = RED, int segments = 24)
+{
+    if (frame().enabled)
+    {
+        frame().circle(cx, cy, radius, color, segments);
+    }
+}
+
+inline auto submit(SDL_Renderer* renderer) -> int
+{
+    return frame().submit(renderer);
+}
+
+#endif // DISABLE_DEBUG_DRAW
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
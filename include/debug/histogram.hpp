@@ -0,0 +1,131 @@
+#pragma once
+
+#include "typedefs.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Log-linear buckets for durations in microseconds, in the style of an HDR
+// histogram: exact below 32us, then 16 buckets per power of two, so a bucket
+// is never more than about 6% wide. Values past 2^24us (~16s) share the last
+// bucket.
+struct LogLinearBuckets {
+    static constexpr uint32      MAX_VALUE = (1u << 24) - 1;
+    static constexpr std::size_t COUNT     = (20 * 16) + 16;
+
+    static constexpr auto index(uint32 value) -> std::size_t
+    {
+        if (value > MAX_VALUE)
+        {
+            value = MAX_VALUE;
+        }
+        if (value < 32)
+        {
+            return value;
+        }
+
+        int const    shift    = std::bit_width(value) - 5;
+        uint32 const mantissa = value >> shift; // 16 to 31.
+        return (static_cast<std::size_t>(shift) * 16) + mantissa;
+    }
+
+    // The highest value that lands in the bucket.
+    static constexpr auto highest(std::size_t index) -> uint32
+    {
+        if (index < 32)
+        {
+            return static_cast<uint32>(index);
+        }
+
+        int const    shift    = static_cast<int>(index / 16) - 1;
+        uint32 const mantissa = static_cast<uint32>(index % 16) + 16;
+        return ((mantissa + 1) << shift) - 1;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Percentiles {
+    float p50{};
+    float p95{};
+    float p99{};
+    float p999{};
+};
+
+// A histogram of the last _Window durations added. Adding is constant time
+// and nothing is allocated, so it can be fed from a tick or a frame.
+template <std::size_t _Window>
+class RollingHistogram {
+public:
+    // Microseconds.
+    void add(uint32 value)
+    {
+        auto const bucket = static_cast<uint16>(LogLinearBuckets::index(value));
+
+        if (filled == _Window)
+        {
+            --counts[window[next]];
+        }
+        else
+        {
+            ++filled;
+        }
+
+        window[next] = bucket;
+        ++counts[bucket];
+        next = (next + 1) % _Window;
+    }
+
+    void add_seconds(double seconds)
+    {
+        double const us = seconds * 1e6;
+        add((us >= LogLinearBuckets::MAX_VALUE) ? LogLinearBuckets::MAX_VALUE : static_cast<uint32>(us));
+    }
+
+    // The smallest bucket value at or below which at least fraction q of the
+    // window lies, microseconds. 0 when empty.
+    auto percentile(double q) const -> uint32
+    {
+        if (filled == 0)
+        {
+            return 0;
+        }
+
+        auto const rank = static_cast<std::size_t>(q * static_cast<double>(filled) + 0.5);
+        std::size_t seen = 0;
+        for (std::size_t i = 0; i < LogLinearBuckets::COUNT; ++i)
+        {
+            seen += counts[i];
+            if ((seen >= rank) && (seen > 0))
+            {
+                return LogLinearBuckets::highest(i);
+            }
+        }
+        return LogLinearBuckets::MAX_VALUE;
+    }
+
+    // Milliseconds.
+    auto percentiles() const -> Percentiles
+    {
+        return {percentile(0.5) / 1000.f,
+                percentile(0.95) / 1000.f,
+                percentile(0.99) / 1000.f,
+                percentile(0.999) / 1000.f};
+    }
+
+    auto size() const noexcept -> std::size_t { return filled; }
+
+private:
+    std::array<uint32, LogLinearBuckets::COUNT> counts{};
+    std::array<uint16, _Window>                 window{};
+    std::size_t                                 next{};
+    std::size_t                                 filled{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
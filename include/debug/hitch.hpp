@@ -0,0 +1,65 @@
+#pragma once
+
+#include "debug/counters.hpp"
+#include "debug/profile.hpp"
+#include <stdio.h>
+#include <string>
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Dumps what led up to a slow frame. When a frame takes longer than the
+// threshold, the profiler's kept frames are written to <prefix>_N.json as a
+// Chrome trace and the recent counter rows to <prefix>_N.csv.
+//
+// Captures are at least COOLDOWN apart so a run of slow frames makes one
+// capture rather than one each, and stop after MAX_CAPTURES so a bad session
+// does not fill the disk.
+class HitchCapture {
+public:
+    static constexpr double COOLDOWN     = 5.0; // Seconds.
+    static constexpr int    MAX_CAPTURES = 20;
+
+    HitchCapture(std::string prefix, double threshold)
+        : prefix(std::move(prefix))
+        , threshold(threshold)
+    {
+    }
+
+    // Call once a frame, after the profiler and telemetry have collected the
+    // frame that took frame_time seconds. Returns true if it was captured.
+    auto check(double frame_time, Profiler& profiler, TelemetryWriter& telemetry) -> bool
+    {
+        since_capture += frame_time;
+
+        if ((frame_time <= threshold) || (since_capture < COOLDOWN) || (captures >= MAX_CAPTURES))
+        {
+            return false;
+        }
+
+        ++captures;
+        since_capture = 0.0;
+
+        std::string const name = prefix + "_" + std::to_string(captures);
+        bool const        ok   = profiler.write_chrome_trace((name + ".json").c_str()) && telemetry.write_recent((name + ".csv").c_str());
+
+        printf("Hitch: frame took %.1f ms, %s %s.json and .csv\n",
+               frame_time * 1000.0,
+               ok ? "wrote" : "could not write",
+               name.c_str());
+        return ok;
+    }
+
+    auto capture_count() const noexcept -> int { return captures; }
+
+private:
+    std::string prefix;
+    double      threshold;
+    double      since_capture{COOLDOWN};
+    int         captures{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "containers/spsc_ring.hpp"
+#include "debug/allocations.hpp"
+#include "typedefs.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+// Scoped timing. PROFILE_SCOPE("name") times the rest of the enclosing block,
+// on any thread. Scopes nest, each sample records how deep it was and how
+// many times it allocated, see debug/allocations.hpp.
+//
+// Each thread writes its samples to a ring of its own, which only the main
+// thread reads, so recording takes no locks. The main thread calls
+// profiler().end_frame() once a frame to collect every ring, and keeps the
+// last FRAMES frames for averages and trace export.
+//
+// Define DISABLE_PROFILE to compile every scope out.
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Nanoseconds on the steady clock.
+inline auto profile_time() -> uint64
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct ProfileSample {
+    char const* name; // Must outlive the profiler, e.g. a string literal.
+    uint64      start;
+    uint64      end;
+    uint32      thread; // Order the thread first recorded in.
+    uint32      depth;
+    uint32      allocations; // Including nested scopes'.
+};
+
+struct ScopeAverage {
+    char const* name;
+    double      ms;          // Per frame.
+    double      calls;       // Per frame.
+    double      allocations; // Per frame.
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t RING_SIZE = 4096;
+    static constexpr std::size_t FRAMES    = 120;
+
+    Profiler()
+        : id(next_id++)
+    {
+    }
+
+    Profiler(Profiler const&) = delete;
+    Profiler& operator=(Profiler const&) = delete;
+
+    // Any thread. Names the calling thread in traces.
+    void name_thread(char const* name)
+    {
+        ThreadRing& r = ring();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        r.name = name;
+    }
+
+    // Any thread. Dropped if the main thread has not collected for a while.
+    void record(char const* name, uint64 start, uint64 end, uint32 depth, uint32 allocations = 0)
+    {
+        ThreadRing& r = ring();
+        if (!r.samples.push(ProfileSample{name, start, end, r.index, depth, allocations}))
+        {
+            r.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Main thread. Collects every thread's samples into a new frame.
+    void end_frame()
+    {
+        std::vector<ProfileSample> samples;
+        if (frames.size() == FRAMES)
+        {
+            samples = std::move(frames.front());
+            frames.pop_front();
+            samples.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& r : rings)
+            {
+                while (ProfileSample const* sample = r->samples.front())
+                {
+                    samples.push_back(*sample);
+                    r->samples.pop();
+                }
+            }
+        }
+
+        frames.push_back(std::move(samples));
+    }
+
+    // Main thread. Time, calls and allocations per frame for each scope over
+    // the kept frames, slowest first.
+    void averages(std::vector<ScopeAverage>& out) const
+    {
+        out.clear();
+        if (frames.empty())
+        {
+            return;
+        }
+
+        for (auto const& frame : frames)
+        {
+            for (auto const& sample : frame)
+            {
+                auto it = std::find_if(out.begin(), out.end(), [&](ScopeAverage const& average) {
+                    return std::strcmp(average.name, sample.name) == 0;
+                });
+                if (it == out.end())
+                {
+                    out.push_back({sample.name, 0.0, 0.0, 0.0});
+                    it = out.end() - 1;
+                }
+
+                it->ms += static_cast<double>(sample.end - sample.start) / 1e6;
+                it->calls += 1.0;
+                it->allocations += sample.allocations;
+            }
+        }
+
+        double const count = static_cast<double>(frames.size());
+        for (auto& average : out)
+        {
+            average.ms /= count;
+            average.calls /= count;
+            average.allocations /= count;
+        }
+
+        std::sort(out.begin(), out.end(), [](ScopeAverage const& a, ScopeAverage const& b) {
+            return a.ms > b.ms;
+        });
+    }
+
+    // Main thread. Samples dropped because a ring was full, all threads.
+    auto dropped() -> uint64
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        uint64 total = 0;
+        for (auto const& r : rings)
+        {
+            total += r->dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    auto frame_count() const noexcept -> std::size_t { return frames.size(); }
+
+    // Main thread. Writes the kept frames as Chrome trace event JSON, for
+    // chrome://tracing or Perfetto. Returns false if the file could not be
+    // written.
+    auto write_chrome_trace(char const* path) -> bool;
+
+private:
+    struct ThreadRing {
+        spsc_ring<ProfileSample, RING_SIZE> samples;
+        std::atomic<uint64>                 dropped{0};
+        char const*                         name{}; // Guarded by mutex.
+        uint32                              index{};
+    };
+
+    struct RingEntry {
+        uint64      owner;
+        ThreadRing* ring;
+    };
+
+    // The calling thread's ring, made on its first sample.
+    auto ring() -> ThreadRing&
+    {
+        // The calling thread's ring in each profiler it has recorded to.
+        // Keyed by id rather than address, a later profiler can be made at
+        // the address of one that is gone. Ids are never reused, so entries
+        // for profilers that are gone are never matched.
+        thread_local std::vector<RingEntry> entries;
+        thread_local RingEntry              last{0, nullptr};
+
+        if (last.owner == id)
+        {
+            return *last.ring;
+        }
+
+        auto it = std::find_if(entries.begin(), entries.end(), [this](RingEntry const& entry) {
+            return entry.owner == id;
+        });
+        if (it == entries.end())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            rings.push_back(std::make_unique<ThreadRing>());
+            rings.back()->index = static_cast<uint32>(rings.size() - 1);
+
+            entries.push_back({id, rings.back().get()});
+            it = entries.end() - 1;
+        }
+
+        last = *it;
+        return *last.ring;
+    }
+
+private:
+    static inline std::atomic<uint64> next_id{1};
+
+    uint64 const id;
+
+    std::mutex                               mutex; // Guards the rings list, not the rings.
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+
+    std::deque<std::vector<ProfileSample>> frames;
+};
+
+inline auto Profiler::write_chrome_trace(char const* path) -> bool
+{
+    FILE* file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        printf("Could not open %s to write the trace.\n", path);
+        return false;
+    }
+
+    uint64 origin = ~uint64(0);
+    for (auto const& frame : frames)
+    {
+        for (auto const& sample : frame)
+        {
+            origin = std::min(origin, sample.start);
+        }
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto const& r : rings)
+        {
+            if (r->name != nullptr)
+            {
+                fprintf(file,
+                        "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                        first ? "" : ",\n",
+                        r->index,
+                        r->name);
+                first = false;
+            }
+        }
+    }
+
+    for (auto const& frame : frames)
+    {
+        for (auto const& sample : frame)
+        {
+            fprintf(file,
+                    "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                    first ? "" : ",\n",
+                    sample.name,
+                    sample.thread,
+                    static_cast<double>(sample.start - origin) / 1e3,
+                    static_cast<double>(sample.end - sample.start) / 1e3);
+            if (sample.allocations != 0)
+            {
+                fprintf(file, ",\"args\":{\"allocations\":%u}", sample.allocations);
+            }
+            fprintf(file, "}");
+            first = false;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    bool const ok = (ferror(file) == 0);
+    fclose(file);
+
+    if (!ok)
+    {
+        printf("Could not write the trace to %s.\n", path);
+    }
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The profiler PROFILE_SCOPE records to.
+inline auto profiler() -> Profiler&
+{
+    static Profiler instance;
+    return instance;
+}
+
+class ProfileScope {
+public:
+    explicit ProfileScope(char const* name, Profiler& target = profiler())
+        : name(name)
+        , target(target)
+        , depth(current_depth++)
+        , allocations(thread_allocations().count)
+        , start(profile_time())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        auto const allocated = static_cast<uint32>(thread_allocations().count - allocations);
+        target.record(name, start, profile_time(), depth, allocated);
+        --current_depth;
+    }
+
+    ProfileScope(ProfileScope const&) = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    static inline thread_local uint32 current_depth = 0;
+
+    char const* name;
+    Profiler&   target;
+    uint32      depth;
+    uint64      allocations;
+    uint64      start;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef DISABLE_PROFILE
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) debug::ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#endif // DISABLE_PROFILE
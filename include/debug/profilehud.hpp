@@ -0,0 +1,121 @@
+#pragma once
+
+#include "debug/histogram.hpp"
+#include "debug/profile.hpp"
+#include "drawing/hudtarget.hpp"
+#include "kiss_sdl.h"
+#include <SDL2/SDL.h>
+#include <array>
+#include <stdio.h>
+#include <vector>
+
+namespace debug {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Dev hud panel with frame and tick time percentiles, then the slowest
+// profile scopes averaged per frame over the profiler's kept frames. The text
+// only changes a few times a second, so it stays readable and the retained
+// texture is rarely redrawn.
+struct ProfileHud {
+    static constexpr int    ROWS            = 20;
+    static constexpr int    PERCENTILE_ROWS = 4; // Header, frame, tick and a gap.
+    static constexpr uint64 REFRESH         = 500'000'000; // ns.
+
+    kiss_window                  window = {0};
+    std::array<kiss_label, ROWS> labels = {};
+    std::vector<ScopeAverage>    averages;
+    uint64                       refreshed{};
+    bool                         dirty = true;
+
+    explicit ProfileHud(SDL_Rect const& rect)
+    {
+        kiss_window_new(&window, NULL, 0, rect.x, rect.y, rect.w, rect.h);
+        window.bg      = {0x10, 0x10, 0x10, 0xc0};
+        window.visible = 1;
+
+        int const border     = 4;
+        int const row_height = kiss_textfont.fontheight + 2;
+
+        for (int i = 0; i < ROWS; ++i)
+        {
+            kiss_label_new(&labels[i],
+                           &window,
+                           "",
+                           window.rect.x + border,
+                           window.rect.y + border + (i * row_height));
+        }
+    }
+
+    // The first rows are frame and tick time percentiles, the rest the
+    // slowest scopes.
+    void update(Profiler& profiler, Percentiles const& frame, Percentiles const& tick)
+    {
+        uint64 const now = profile_time();
+        if ((now - refreshed) < REFRESH)
+        {
+            return;
+        }
+        refreshed = now;
+
+        profiler.averages(averages);
+
+        snprintf(labels[0].text, sizeof(labels[0].text), "%-8s %6s %6s %6s %6s", "ms", "p50", "p95", "p99", "p99.9");
+        print_percentiles(labels[1].text, sizeof(labels[1].text), "frame", frame);
+        print_percentiles(labels[2].text, sizeof(labels[2].text), "tick", tick);
+
+        for (int i = PERCENTILE_ROWS; i < ROWS; ++i)
+        {
+            auto&     text  = labels[i].text;
+            int const scope = i - PERCENTILE_ROWS - 1;
+            if (scope < 0)
+            {
+                snprintf(text, sizeof(text), "%-20s %7s %6s %6s", "scope", "ms", "calls", "allocs");
+            }
+            else if (static_cast<std::size_t>(scope) < averages.size())
+            {
+                auto const& average = averages[scope];
+                snprintf(text, sizeof(text), "%-20.20s %7.3f %6.1f %6.1f", average.name, average.ms, average.calls, average.allocations);
+            }
+            else
+            {
+                text[0] = '\0';
+            }
+        }
+        dirty = true;
+    }
+
+    // Renders into target, which is retained between calls, only if the text
+    // changed. Pass force to redraw anyway. Returns true if anything was drawn.
+    auto render(SDL_Renderer* renderer, drawing::HudTarget const& target, bool force = false) -> bool
+    {
+        if (!dirty && !force)
+        {
+            return false;
+        }
+        dirty = false;
+
+        target.begin(renderer);
+        SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0x00);
+        SDL_RenderClear(renderer);
+
+        kiss_window_draw(&window, renderer);
+        for (auto& label : labels)
+        {
+            kiss_label_draw(&label, renderer);
+        }
+
+        target.end(renderer);
+        return true;
+    }
+
+private:
+    static void print_percentiles(char* text, std::size_t size, char const* name, Percentiles const& p)
+    {
+        snprintf(text, size, "%-8s %6.2f %6.2f %6.2f %6.2f", name, p.p50, p.p95, p.p99, p.p999);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "assets/assetcache.hpp"
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <array>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Images packed into the sprite atlas. Sizes are known at build time so the
+// layout, and every frame rect derived from it, is computed at compile time.
+// build_atlas checks the images on disk still match.
+struct AtlasImage {
+    char const* file_name;
+    int         w;
+    int         h;
+};
+
+enum AtlasId {
+    ATLAS_LRUP_TEST,
+    ATLAS_PLAYER,
+    ATLAS_IMAGE_COUNT
+};
+
+constexpr std::array<AtlasImage, ATLAS_IMAGE_COUNT> ATLAS_IMAGES{{
+    {"lruptest.png", 160, 320},
+    {"player.png", 80, 80},
+}};
+
+constexpr int ATLAS_MAX_WIDTH = 512;
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <std::size_t N>
+struct AtlasLayout {
+    std::array<SDL_Rect, N> rects;
+    int                     w;
+    int                     h;
+};
+
+// Shelf packer. Images are placed left to right in the order given, starting
+// a new shelf when the row is full. Order images tallest first for the best
+// fit.
+template <std::size_t N>
+constexpr auto pack_atlas(std::array<AtlasImage, N> const& images, int max_width) -> AtlasLayout<N>
+{
+    AtlasLayout<N> layout{};
+
+    int x            = 0;
+    int y            = 0;
+    int shelf_height = 0;
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto const& image = images[i];
+
+        if ((x + image.w) > max_width)
+        {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+
+        layout.rects[i] = SDL_Rect{x, y, image.w, image.h};
+
+        x += image.w;
+        shelf_height = (image.h > shelf_height) ? image.h : shelf_height;
+        layout.w     = (x > layout.w) ? x : layout.w;
+    }
+
+    layout.h = y + shelf_height;
+    return layout;
+}
+
+constexpr auto ATLAS_LAYOUT = pack_atlas(ATLAS_IMAGES, ATLAS_MAX_WIDTH);
+
+static_assert(ATLAS_LAYOUT.w <= ATLAS_MAX_WIDTH);
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Frame rects for a sprite sheet laid out as a grid, row major.
+template <int Cols, int Rows>
+constexpr auto make_grid_frames(SDL_Rect region) -> std::array<SDL_Rect, Cols * Rows>
+{
+    std::array<SDL_Rect, Cols * Rows> frames{};
+
+    int const frame_width  = region.w / Cols;
+    int const frame_height = region.h / Rows;
+
+    for (int row = 0; row < Rows; ++row)
+    {
+        for (int col = 0; col < Cols; ++col)
+        {
+            frames[(row * Cols) + col] = SDL_Rect{region.x + (col * frame_width),
+                                                  region.y + (row * frame_height),
+                                                  frame_width,
+                                                  frame_height};
+        }
+    }
+    return frames;
+}
+
+// Left, right, up, down walk cycle, two frames per direction.
+constexpr auto LRUP_TEST_FRAMES = make_grid_frames<2, 4>(ATLAS_LAYOUT.rects[ATLAS_LRUP_TEST]);
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Atlas {
+    SDL_Texture* texture;
+    int          w;
+    int          h;
+
+    // ARGB8888 copy of the texture for CPU rendering, empty unless asked for.
+    std::vector<uint32> pixels;
+};
+
+// Loads the images in ATLAS_IMAGES through the asset cache and packs them into
+// a single texture using ATLAS_LAYOUT. The images are released again once
+// packed. Returns an atlas with a null texture on failure.
+auto build_atlas(SDL_Renderer* renderer, assets::AssetCache& cache, bool keep_pixels = false) -> Atlas;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "drawing/atlas.hpp"
+#include "screen.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr SDL_Color WHITE{0xff, 0xff, 0xff, 0xff};
+constexpr SDL_Color RED{0xff, 0x00, 0x00, 0xff};
+constexpr SDL_Color GREEN{0x00, 0xff, 0x00, 0xff};
+constexpr SDL_Color BLUE{0x00, 0x00, 0xff, 0xff};
+constexpr SDL_Color GREY{0xA0, 0xA0, 0xA0, 0xff};
+
+// Collects quads for a frame and draws them with as few SDL_RenderGeometry
+// calls as possible.
+//
+// Quads are given in world coordinates (y up) and flipped into screen space as
+// they are added. Colour is per vertex, so consecutive quads only start a new
+// draw call when the texture changes; all untextured quads between two sprites
+// are one call whatever their colours. Draw order is the order quads are
+// added in.
+//
+// Untextured quads are drawn with the blend mode set by set_blend_mode, sprites
+// with their texture's own blend mode.
+//
+// The vertex and index buffers are kept between frames, clear() only resets
+// their size.
+class QuadBatch {
+public:
+    struct Run {
+        SDL_Texture*  texture;
+        SDL_BlendMode blend;
+        int           first_vertex;
+        int           vertex_count;
+        int           first_index;
+        int           index_count;
+    };
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+        runs.clear();
+        blend = SDL_BLENDMODE_NONE;
+    }
+
+    void set_blend_mode(SDL_BlendMode mode) { blend = mode; }
+
+    void reserve(std::size_t quads)
+    {
+        vertices.reserve(quads * 4);
+        indices.reserve(quads * 6);
+    }
+
+    void fill_rect(SDL_FRect const& rect, SDL_Color color)
+    {
+        add_quad(nullptr, rect, color, SDL_FRect{0.f, 0.f, 0.f, 0.f});
+    }
+
+    // SDL_RenderDrawRectF equivalent, one pixel thick edges inside rect.
+    void outline_rect(SDL_FRect const& rect, SDL_Color color)
+    {
+        constexpr float t = 1.f;
+
+        fill_rect({rect.x, rect.y, rect.w, t}, color);
+        fill_rect({rect.x, rect.y + rect.h - t, rect.w, t}, color);
+        fill_rect({rect.x, rect.y + t, t, rect.h - (2 * t)}, color);
+        fill_rect({rect.x + rect.w - t, rect.y + t, t, rect.h - (2 * t)}, color);
+    }
+
+    void sprite(SDL_Texture*     texture,
+                int              texture_w,
+                int              texture_h,
+                SDL_Rect const&  src,
+                SDL_FRect const& dst,
+                SDL_Color        tint = WHITE)
+    {
+        float const inv_w = 1.f / static_cast<float>(texture_w);
+        float const inv_h = 1.f / static_cast<float>(texture_h);
+
+        SDL_FRect const uv{src.x * inv_w, src.y * inv_h, src.w * inv_w, src.h * inv_h};
+        add_quad(texture, dst, tint, uv);
+    }
+
+    void sprite(Atlas const& atlas, SDL_Rect const& src, SDL_FRect const& dst, SDL_Color tint = WHITE)
+    {
+        sprite(atlas.texture, atlas.w, atlas.h, src, dst, tint);
+    }
+
+    // Draws everything added since clear(). Returns the number of draw calls
+    // made.
+    auto submit(SDL_Renderer* renderer) const -> int;
+
+    auto quad_count() const noexcept -> std::size_t { return vertices.size() / 4; }
+    auto run_list() const noexcept -> std::vector<Run> const& { return runs; }
+    auto vertex_list() const noexcept -> std::vector<SDL_Vertex> const& { return vertices; }
+    auto index_list() const noexcept -> std::vector<int> const& { return indices; }
+
+private:
+    void add_quad(SDL_Texture* texture, SDL_FRect const& rect, SDL_Color color, SDL_FRect const& uv)
+    {
+        // The blend mode only matters to untextured runs.
+        SDL_BlendMode const run_blend = (texture == nullptr) ? blend : SDL_BLENDMODE_NONE;
+
+        if (runs.empty() || (runs.back().texture != texture) || (runs.back().blend != run_blend))
+        {
+            runs.push_back(Run{texture,
+                               run_blend,
+                               static_cast<int>(vertices.size()),
+                               0,
+                               static_cast<int>(indices.size()),
+                               0});
+        }
+        auto& run = runs.back();
+
+        // World rects are anchored bottom left, y up.
+        float const left   = rect.x;
+        float const right  = rect.x + rect.w;
+        float const top    = to_screen_y(rect.y + rect.h);
+        float const bottom = to_screen_y(rect.y);
+
+        float const u0 = uv.x;
+        float const u1 = uv.x + uv.w;
+        float const v0 = uv.y;
+        float const v1 = uv.y + uv.h;
+
+        // Indices are relative to the run so each run is drawn from its own
+        // slice of the vertex buffer.
+        int const base = run.vertex_count;
+
+        vertices.push_back(SDL_Vertex{{left, top}, color, {u0, v0}});
+        vertices.push_back(SDL_Vertex{{right, top}, color, {u1, v0}});
+        vertices.push_back(SDL_Vertex{{right, bottom}, color, {u1, v1}});
+        vertices.push_back(SDL_Vertex{{left, bottom}, color, {u0, v1}});
+
+        indices.push_back(base + 0);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base + 0);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+
+        run.vertex_count += 4;
+        run.index_count += 6;
+    }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int>        indices;
+    std::vector<Run>        runs;
+    SDL_BlendMode           blend{SDL_BLENDMODE_NONE};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "drawing/atlas.hpp"
+#include "drawing/batch.hpp"
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Draw commands are sorted by a 64 bit key before they reach the batch, most
+// significant field first:
+//
+//   63..56  layer
+//   55..40  texture id, 0 for untextured
+//   39..32  blend
+//   31..0   depth
+//
+// Layers are strictly ordered. Within a layer, commands are grouped by texture
+// and then blend mode so each group is one draw call, and depth orders the
+// commands inside a group. Commands with equal keys keep the order they were
+// added in.
+//
+// Texture ids only group draws within a layer, an untextured rect sorts before
+// every sprite in its layer. Anything that has to draw over a sprite, whatever
+// its texture, needs a layer above the sprite's.
+
+enum class Layer : uint8 {
+    GROUND,
+    ENTITIES,    // Players.
+    PROJECTILES, // Bullets, over the players.
+    PICKUPS,     // Food, over the players and bullets.
+    OVERLAY,
+};
+
+// Matches SDL_BLENDMODE_NONE and SDL_BLENDMODE_BLEND.
+enum class Blend : uint8 {
+    NONE,
+    BLEND,
+};
+
+constexpr auto make_sort_key(Layer layer, uint16 texture_id, Blend blend, uint32 depth) -> uint64
+{
+    return (uint64(layer) << 56) | (uint64(texture_id) << 40) | (uint64(blend) << 32) | uint64(depth);
+}
+
+constexpr auto key_layer(uint64 key) -> Layer { return static_cast<Layer>(key >> 56); }
+constexpr auto key_texture_id(uint64 key) -> uint16 { return static_cast<uint16>(key >> 40); }
+constexpr auto key_blend(uint64 key) -> Blend { return static_cast<Blend>((key >> 32) & 0xff); }
+constexpr auto key_depth(uint64 key) -> uint32 { return static_cast<uint32>(key); }
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct DrawCommand {
+    uint64       key;
+    SDL_Texture* texture; // nullptr for a filled rect.
+    int          texture_w;
+    int          texture_h;
+    SDL_Rect     src;
+    SDL_FRect    dst; // World coordinates, like QuadBatch.
+    SDL_Color    color;
+};
+
+// A frame's draw commands. Recording only reads its inputs and touches no SDL
+// state, so a list can be filled on any thread and handed over for sort() and
+// append_to() on the render thread.
+//
+// Storage is kept between frames, clear() only resets sizes.
+class CommandList {
+public:
+    void clear()
+    {
+        commands.clear();
+        order.clear();
+        sorted = true;
+    }
+
+    void reserve(std::size_t count) { commands.reserve(count); }
+
+    void fill_rect(Layer            layer,
+                   SDL_FRect const& rect,
+                   SDL_Color        color,
+                   Blend            blend = Blend::NONE,
+                   uint32           depth = 0)
+    {
+        push(DrawCommand{make_sort_key(layer, 0, blend, depth), nullptr, 0, 0, {}, rect, color});
+    }
+
+    void sprite(Layer            layer,
+                Atlas const&     atlas,
+                SDL_Rect const&  src,
+                SDL_FRect const& dst,
+                uint32           depth = 0,
+                SDL_Color        tint  = WHITE)
+    {
+        // Sprites use their texture's blend mode, the atlas blends.
+        push(DrawCommand{make_sort_key(layer, texture_id(atlas.texture), Blend::BLEND, depth),
+                         atlas.texture,
+                         atlas.w,
+                         atlas.h,
+                         src,
+                         dst,
+                         tint});
+    }
+
+    // Orders the commands by key. Stable, so commands with equal keys draw in
+    // the order they were added.
+    void sort();
+
+    // Appends the sorted commands to batch.
+    void append_to(QuadBatch& batch) const
+    {
+        assert(sorted);
+
+        for (uint32 index : order)
+        {
+            DrawCommand const& command = commands[index];
+
+            if (command.texture == nullptr)
+            {
+                batch.set_blend_mode((key_blend(command.key) == Blend::BLEND) ? SDL_BLENDMODE_BLEND
+                                                                               : SDL_BLENDMODE_NONE);
+                batch.fill_rect(command.dst, command.color);
+            }
+            else
+            {
+                batch.sprite(command.texture,
+                             command.texture_w,
+                             command.texture_h,
+                             command.src,
+                             command.dst,
+                             command.color);
+            }
+        }
+    }
+
+    auto size() const noexcept -> std::size_t { return commands.size(); }
+    auto command_list() const noexcept -> std::vector<DrawCommand> const& { return commands; }
+
+    // Indices into command_list() in draw order, valid after sort().
+    auto draw_order() const noexcept -> std::vector<uint32> const& { return order; }
+
+    // Ids are handed out on first use and kept for the life of the list, so
+    // the texture order is the same every frame.
+    auto texture_id(SDL_Texture* texture) -> uint16
+    {
+        if (texture == nullptr)
+        {
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < textures.size(); ++i)
+        {
+            if (textures[i] == texture)
+            {
+                return static_cast<uint16>(i + 1);
+            }
+        }
+
+        assert(textures.size() < 0xffff);
+        textures.push_back(texture);
+        return static_cast<uint16>(textures.size());
+    }
+
+private:
+    void push(DrawCommand const& command)
+    {
+        commands.push_back(command);
+        sorted = false;
+    }
+
+    struct SortEntry {
+        uint64 key;
+        uint32 index;
+    };
+
+private:
+    std::vector<DrawCommand>  commands;
+    std::vector<uint32>       order;
+    std::vector<SortEntry>    entries;
+    std::vector<SortEntry>    scratch;
+    std::vector<SDL_Texture*> textures;
+    bool                      sorted{true};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Least significant digit radix sort, a byte at a time. All eight histograms
+// are built in one pass, and bytes that are the same in every key are skipped,
+// which is most of them: there are only a few layers, textures and blend
+// modes, and depth is often left at 0.
+inline void CommandList::sort()
+{
+    std::size_t const n = commands.size();
+
+    entries.resize(n);
+    scratch.resize(n);
+
+    std::array<std::array<uint32, 256>, 8> counts{};
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        uint64 const key = commands[i].key;
+        entries[i]       = SortEntry{key, static_cast<uint32>(i)};
+
+        for (int digit = 0; digit < 8; ++digit)
+        {
+            ++counts[digit][(key >> (digit * 8)) & 0xff];
+        }
+    }
+
+    SortEntry* from = entries.data();
+    SortEntry* to   = scratch.data();
+
+    for (int digit = 0; digit < 8; ++digit)
+    {
+        auto& count = counts[digit];
+
+        int const shift = digit * 8;
+        if ((n == 0) || (count[(from[0].key >> shift) & 0xff] == n))
+        {
+            continue;
+        }
+
+        // Counts to starting offsets.
+        uint32 offset = 0;
+        for (auto& c : count)
+        {
+            uint32 const bucket = c;
+            c                   = offset;
+            offset += bucket;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            to[count[(from[i].key >> shift) & 0xff]++] = from[i];
+        }
+
+        std::swap(from, to);
+    }
+
+    order.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        order[i] = from[i].index;
+    }
+
+    sorted = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -1,9 +1,8 @@
 #pragma once
 
-#include "drawing/drawmatrix.hpp"
-
-namespace drawing {
-
-void draw_vector(SDL_Renderer* renderer, float px, float py, float vx, float vy);
-
-}
+#include "drawing/atlas.hpp"
+#include "drawing/batch.hpp"
+#include "drawing/commands.hpp"
+#include "drawing/shapebatch.hpp"
+#include "drawing/softraster.hpp"
+#include "drawing/staticlayer.hpp"
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The viewport that draws screen_rect's contents into a texture of its size.
+//
+// The viewport's origin is where screen (0, 0) lands on the texture, so it is
+// moved up and left by the window's position. SDL clips drawing to the
+// viewport, so it also has to reach the texture's far edge: its size is the
+// window's size plus the distance its origin was moved, x + w by y + h.
+// Everything left of or above the window falls off the texture.
+inline auto hud_viewport(SDL_Rect const& screen_rect) -> SDL_Rect
+{
+    return SDL_Rect{-screen_rect.x,
+                    -screen_rect.y,
+                    screen_rect.x + screen_rect.w,
+                    screen_rect.y + screen_rect.h};
+}
+
+// A render target covering just one window's rect on screen, rather than the
+// whole screen.
+//
+// kiss widgets are positioned in screen coordinates. begin() sets a viewport
+// that shifts the window's rect onto the texture so they draw unchanged, see
+// hud_viewport.
+class HudTarget {
+public:
+    HudTarget(SDL_Renderer* renderer, SDL_Rect const& screen_rect);
+    ~HudTarget();
+
+    HudTarget(HudTarget const&) = delete;
+    auto operator=(HudTarget const&) -> HudTarget& = delete;
+
+    auto valid() const noexcept -> bool { return texture != nullptr; }
+    auto rect() const noexcept -> SDL_Rect const& { return screen_rect; }
+
+    // Redirects drawing into the texture until end().
+    void begin(SDL_Renderer* renderer) const;
+    void end(SDL_Renderer* renderer) const;
+
+    // Copies the texture to its rect on the current target.
+    void draw(SDL_Renderer* renderer) const;
+
+private:
+    SDL_Texture* texture{};
+    SDL_Rect     screen_rect{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "drawing/batch.hpp"
+#include "typedefs.h"
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Render backend for headless runs. Takes the same batches the window would
+// draw, and keeps count of what would have been drawn instead of drawing it.
+struct NullRenderer {
+    uint64 frames{};
+    uint64 quads{};
+    uint64 draw_calls{};
+
+    // Same contract as QuadBatch::submit.
+    auto submit(QuadBatch const& batch) -> int
+    {
+        int const calls = static_cast<int>(batch.run_list().size());
+
+        quads += batch.quad_count();
+        draw_calls += calls;
+        return calls;
+    }
+
+    void present() { ++frames; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
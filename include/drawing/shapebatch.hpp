@@ -0,0 +1,96 @@
+#pragma once
+
+#include "screen.h"
+#include "shapes.hpp"
+#include <SDL2/SDL.h>
+#include <span>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Filled shapes from shapes.hpp as triangle fans, drawn with one
+// SDL_RenderGeometry call however many there are.
+//
+// Shapes are transformed in bulk: one affine per shape, applied to its
+// segment count's shared unit circle with affine_points, straight into the
+// vertex buffer. Shapes are in world coordinates (y up), the flip to screen
+// space is folded into the affine.
+//
+// The buffers are kept between frames, clear() only resets their size.
+class ShapeBatch {
+public:
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+        shapes = 0;
+    }
+
+    template <size_t NumSegments>
+    void add(std::span<Shape<NumSegments> const> instances, SDL_Color color)
+    {
+        constexpr size_t n = NumSegments;
+
+        auto const& unit = UNIT_CIRCLE<NumSegments>;
+
+        vertices.reserve(vertices.size() + (instances.size() * (n + 1)));
+        indices.reserve(indices.size() + (instances.size() * n * 3));
+
+        float xs[n];
+        float ys[n];
+
+        for (auto const& shape : instances)
+        {
+            Affine m = shape_affine(shape.radius, shape.theta, shape.x, shape.y);
+
+            // Flip into screen space.
+            m.c  = -m.c;
+            m.d  = -m.d;
+            m.ty = to_screen_y(m.ty);
+
+            affine_points(unit.x.data(), unit.y.data(), n, m, xs, ys);
+
+            int const center = static_cast<int>(vertices.size());
+
+            vertices.push_back(SDL_Vertex{{m.tx, m.ty}, color, {0.f, 0.f}});
+            for (size_t i = 0; i < n; ++i)
+            {
+                vertices.push_back(SDL_Vertex{{xs[i], ys[i]}, color, {0.f, 0.f}});
+            }
+
+            for (int i = 0; i < static_cast<int>(n); ++i)
+            {
+                indices.push_back(center);
+                indices.push_back(center + 1 + i);
+                indices.push_back(center + 1 + ((i + 1) % static_cast<int>(n)));
+            }
+        }
+
+        shapes += instances.size();
+    }
+
+    template <size_t NumSegments>
+    void add(Shape<NumSegments> const& shape, SDL_Color color)
+    {
+        add(std::span<Shape<NumSegments> const>(&shape, 1), color);
+    }
+
+    // Draws everything added since clear(). Returns the number of draw calls
+    // made.
+    auto submit(SDL_Renderer* renderer) const -> int;
+
+    auto shape_count() const noexcept -> size_t { return shapes; }
+    auto vertex_list() const noexcept -> std::vector<SDL_Vertex> const& { return vertices; }
+    auto index_list() const noexcept -> std::vector<int> const& { return indices; }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int>        indices;
+    size_t                  shapes{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
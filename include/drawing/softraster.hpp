@@ -0,0 +1,342 @@
+#pragma once
+
+#include "drawing/batch.hpp"
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// CPU rasteriser for QuadBatch contents, for machines where SDL would fall
+// back to its single threaded software renderer.
+//
+// The frame's quads are binned into RASTER_TILE_SIZE square screen tiles.
+// Each tile is then cleared and drawn independently, so tiles are spread over
+// worker threads with no locking. Pixels are ARGB8888. Spans are written with
+// plain loops over contiguous pixels, with no calls or branches on the
+// per-pixel path, so the compiler vectorises them.
+//
+// QuadBatch only produces axis aligned quads, which is all this handles.
+
+constexpr int RASTER_TILE_SIZE = 64;
+
+// CPU copy of a texture, ARGB8888, tightly packed.
+struct RasterTexture {
+    SDL_Texture*  key;
+    uint32 const* pixels;
+    int           w;
+    int           h;
+};
+
+struct RasterQuad {
+    // Pixel bounds, x0 <= x < x1 and y0 <= y < y1.
+    int x0, y0, x1, y1;
+
+    // Texel coordinates of pixel (x0, y0) and the step per pixel, 16.16.
+    int32 u, v, du, dv;
+
+    uint32 color;
+    int    texture; // Into RasterFrame::textures, or -1.
+    bool   blend;   // Untextured only, false overwrites.
+};
+
+struct RasterFrame {
+    int width{};
+    int height{};
+    int tiles_x{};
+    int tiles_y{};
+
+    std::vector<RasterTexture>       textures;
+    std::vector<RasterQuad>          quads;
+    std::vector<std::vector<uint32>> bins;
+
+    auto tile_count() const noexcept -> int { return tiles_x * tiles_y; }
+
+    void resize(int w, int h)
+    {
+        width   = w;
+        height  = h;
+        tiles_x = (w + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+        tiles_y = (h + RASTER_TILE_SIZE - 1) / RASTER_TILE_SIZE;
+        bins.resize(tile_count());
+    }
+
+    auto find_texture(SDL_Texture* key) const -> int
+    {
+        for (std::size_t i = 0; i < textures.size(); ++i)
+        {
+            if (textures[i].key == key)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline auto pack_argb(SDL_Color c) -> uint32
+{
+    return (uint32(c.a) << 24) | (uint32(c.r) << 16) | (uint32(c.g) << 8) | uint32(c.b);
+}
+
+// x / 255 for x in [0, 255 * 255], exact.
+inline auto div255(uint32 x) -> uint32
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// SDL_BLENDMODE_BLEND: rgb = src * a + dst * (1 - a), a = a + dst.a * (1 - a).
+inline auto blend_argb(uint32 src, uint32 dst) -> uint32
+{
+    uint32 const a  = src >> 24;
+    uint32 const ia = 255 - a;
+
+    uint32 const r  = div255((((src >> 16) & 0xff) * a) + (((dst >> 16) & 0xff) * ia));
+    uint32 const g  = div255((((src >> 8) & 0xff) * a) + (((dst >> 8) & 0xff) * ia));
+    uint32 const b  = div255(((src & 0xff) * a) + ((dst & 0xff) * ia));
+    uint32 const oa = a + div255((dst >> 24) * ia);
+
+    return (oa << 24) | (r << 16) | (g << 8) | b;
+}
+
+// Per channel product, for tinting texels by the vertex colour.
+inline auto modulate_argb(uint32 texel, uint32 tint) -> uint32
+{
+    uint32 const a = div255((texel >> 24) * (tint >> 24));
+    uint32 const r = div255(((texel >> 16) & 0xff) * ((tint >> 16) & 0xff));
+    uint32 const g = div255(((texel >> 8) & 0xff) * ((tint >> 8) & 0xff));
+    uint32 const b = div255((texel & 0xff) * (tint & 0xff));
+
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Converts the batch to pixel space quads and bins them by tile, keeping the
+// batch's draw order within every bin. Textures must already be registered in
+// frame.textures, sprites with unknown textures are skipped.
+inline void bin_quads(QuadBatch const& batch, RasterFrame& frame)
+{
+    frame.quads.clear();
+    for (auto& bin : frame.bins)
+    {
+        bin.clear();
+    }
+
+    auto const& vertices = batch.vertex_list();
+
+    for (auto const& run : batch.run_list())
+    {
+        int texture_index = -1;
+        if (run.texture != nullptr)
+        {
+            texture_index = frame.find_texture(run.texture);
+            if (texture_index < 0)
+            {
+                continue;
+            }
+        }
+
+        for (int q = 0; q < run.vertex_count; q += 4)
+        {
+            // Vertices are top left, top right, bottom right, bottom left.
+            SDL_Vertex const& tl = vertices[run.first_vertex + q];
+            SDL_Vertex const& br = vertices[run.first_vertex + q + 2];
+
+            // Pixels whose centres are inside the quad.
+            int const x0 = static_cast<int>(std::ceil(tl.position.x - 0.5f));
+            int const y0 = static_cast<int>(std::ceil(tl.position.y - 0.5f));
+            int const x1 = static_cast<int>(std::ceil(br.position.x - 0.5f));
+            int const y1 = static_cast<int>(std::ceil(br.position.y - 0.5f));
+
+            int const cx0 = std::max(x0, 0);
+            int const cy0 = std::max(y0, 0);
+            int const cx1 = std::min(x1, frame.width);
+            int const cy1 = std::min(y1, frame.height);
+            if ((cx0 >= cx1) || (cy0 >= cy1))
+            {
+                continue;
+            }
+
+            RasterQuad quad{cx0,
+                            cy0,
+                            cx1,
+                            cy1,
+                            0,
+                            0,
+                            0,
+                            0,
+                            pack_argb(tl.color),
+                            texture_index,
+                            run.blend == SDL_BLENDMODE_BLEND};
+
+            if (texture_index >= 0)
+            {
+                auto const& texture = frame.textures[texture_index];
+
+                float const w = br.position.x - tl.position.x;
+                float const h = br.position.y - tl.position.y;
+
+                float const du = (br.tex_coord.x - tl.tex_coord.x) * texture.w / w;
+                float const dv = (br.tex_coord.y - tl.tex_coord.y) * texture.h / h;
+
+                // Sample at the centre of the first clipped pixel.
+                float const u = (tl.tex_coord.x * texture.w) + ((cx0 + 0.5f - tl.position.x) * du);
+                float const v = (tl.tex_coord.y * texture.h) + ((cy0 + 0.5f - tl.position.y) * dv);
+
+                quad.u  = static_cast<int32>(u * 65536.f);
+                quad.v  = static_cast<int32>(v * 65536.f);
+                quad.du = static_cast<int32>(du * 65536.f);
+                quad.dv = static_cast<int32>(dv * 65536.f);
+            }
+
+            auto const index = static_cast<uint32>(frame.quads.size());
+            frame.quads.push_back(quad);
+
+            int const tx0 = cx0 / RASTER_TILE_SIZE;
+            int const ty0 = cy0 / RASTER_TILE_SIZE;
+            int const tx1 = (cx1 - 1) / RASTER_TILE_SIZE;
+            int const ty1 = (cy1 - 1) / RASTER_TILE_SIZE;
+
+            for (int ty = ty0; ty <= ty1; ++ty)
+            {
+                for (int tx = tx0; tx <= tx1; ++tx)
+                {
+                    frame.bins[(ty * frame.tiles_x) + tx].push_back(index);
+                }
+            }
+        }
+    }
+}
+
+// Clears one tile and draws its quads into pixels, pitch in pixels.
+inline void rasterize_tile(RasterFrame const& frame, int tile, uint32 clear, uint32* pixels, int pitch)
+{
+    int const tile_x0 = (tile % frame.tiles_x) * RASTER_TILE_SIZE;
+    int const tile_y0 = (tile / frame.tiles_x) * RASTER_TILE_SIZE;
+    int const tile_x1 = std::min(tile_x0 + RASTER_TILE_SIZE, frame.width);
+    int const tile_y1 = std::min(tile_y0 + RASTER_TILE_SIZE, frame.height);
+
+    for (int y = tile_y0; y < tile_y1; ++y)
+    {
+        std::fill(pixels + (y * pitch) + tile_x0, pixels + (y * pitch) + tile_x1, clear);
+    }
+
+    for (uint32 index : frame.bins[tile])
+    {
+        RasterQuad const& quad = frame.quads[index];
+
+        int const x0 = std::max(quad.x0, tile_x0);
+        int const y0 = std::max(quad.y0, tile_y0);
+        int const x1 = std::min(quad.x1, tile_x1);
+        int const y1 = std::min(quad.y1, tile_y1);
+        int const n  = x1 - x0;
+
+        if (quad.texture < 0)
+        {
+            uint32 const color = quad.color;
+
+            if (!quad.blend || ((color >> 24) == 0xff))
+            {
+                for (int y = y0; y < y1; ++y)
+                {
+                    std::fill_n(pixels + (y * pitch) + x0, n, color);
+                }
+            }
+            else
+            {
+                for (int y = y0; y < y1; ++y)
+                {
+                    uint32* __restrict row = pixels + (y * pitch) + x0;
+                    for (int i = 0; i < n; ++i)
+                    {
+                        row[i] = blend_argb(color, row[i]);
+                    }
+                }
+            }
+            continue;
+        }
+
+        auto const& texture = frame.textures[quad.texture];
+
+        int32 const u_start = quad.u + ((x0 - quad.x0) * quad.du);
+        int32       v       = quad.v + ((y0 - quad.y0) * quad.dv);
+
+        for (int y = y0; y < y1; ++y, v += quad.dv)
+        {
+            int const          ty     = std::clamp(v >> 16, 0, texture.h - 1);
+            uint32 const*      texels = texture.pixels + (ty * texture.w);
+            uint32* __restrict row    = pixels + (y * pitch) + x0;
+
+            int32 u = u_start;
+            for (int i = 0; i < n; ++i, u += quad.du)
+            {
+                int const    tx    = std::clamp(u >> 16, 0, texture.w - 1);
+                uint32 const texel = modulate_argb(texels[tx], quad.color);
+                row[i]             = blend_argb(texel, row[i]);
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Rasterises batches on a pool of threads and presents the result as one
+// streaming texture.
+class SoftRasterizer {
+public:
+    // threads = 0 uses one per hardware thread. The calling thread always
+    // helps, so threads = 1 spawns no workers.
+    SoftRasterizer(SDL_Renderer* renderer, int width, int height, int threads = 0);
+    ~SoftRasterizer();
+
+    SoftRasterizer(SoftRasterizer const&) = delete;
+    auto operator=(SoftRasterizer const&) -> SoftRasterizer& = delete;
+
+    auto valid() const noexcept -> bool { return texture != nullptr; }
+
+    // Makes a texture's pixels available to sprites drawn with it. The pixels
+    // must be ARGB8888 and outlive the rasteriser.
+    void bind_texture(SDL_Texture* key, uint32 const* pixels, int w, int h);
+
+    // Rasterises batch over clear into the streaming texture and copies it to
+    // the current render target.
+    void render(SDL_Renderer* renderer, QuadBatch const& batch, SDL_Color clear);
+
+private:
+    void worker_loop();
+    void run_tiles();
+
+private:
+    SDL_Texture* texture{};
+    RasterFrame  frame;
+
+    // Set per frame, read by workers.
+    uint32*          pixels{};
+    int              pitch{};
+    uint32           clear_color{};
+    std::atomic<int> next_tile{};
+    std::atomic<int> tiles_done{};
+
+    std::mutex               mutex;
+    std::condition_variable  frame_ready;
+    std::condition_variable  frame_done;
+    uint64                   generation{};
+    bool                     stopping{};
+    std::vector<std::thread> workers;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "drawing/batch.hpp"
+#include "typedefs.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace drawing {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Geometry that does not move, rendered once into a screen sized texture and
+// then drawn each frame with a single copy.
+//
+// The layer is rebuilt when any of the versions passed to update() differ from
+// the last build, e.g. sparse_set::version() of the sets it draws plus any
+// toggles that change what is drawn.
+class StaticLayer {
+public:
+    StaticLayer() = default;
+    ~StaticLayer();
+
+    StaticLayer(StaticLayer const&) = delete;
+    auto operator=(StaticLayer const&) -> StaticLayer& = delete;
+
+    // Calls build(QuadBatch&) and renders the result if the layer is stale.
+    // Returns true if it was rebuilt.
+    template <typename Fn>
+    auto update(SDL_Renderer* renderer, std::initializer_list<uint32> versions, Fn&& build) -> bool
+    {
+        bool const stale = (texture == nullptr) ||
+                           !std::equal(versions.begin(),
+                                       versions.end(),
+                                       built_versions.begin(),
+                                       built_versions.end());
+        if (!stale)
+        {
+            return false;
+        }
+
+        batch.clear();
+        build(batch);
+
+        if (!render(renderer))
+        {
+            return false;
+        }
+
+        built_versions.assign(versions.begin(), versions.end());
+        return true;
+    }
+
+    // Forces a rebuild on the next update, e.g. when render targets are lost.
+    void invalidate() noexcept { built_versions.clear(); }
+
+    void draw(SDL_Renderer* renderer) const;
+
+private:
+    auto render(SDL_Renderer* renderer) -> bool;
+
+private:
+    SDL_Texture*        texture{};
+    QuadBatch           batch;
+    std::vector<uint32> built_versions;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
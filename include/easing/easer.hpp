@@ -1,7 +1,9 @@
 #pragma once
 
-#include "utility/vecref.hpp"
-#include <vector>
+#include "containers/slot_map.hpp"
+#include "easing/timerwheel.hpp"
+#include "easing/tween.hpp"
+#include <utility>
 
 namespace easing {
 
@@ -16,68 +18,123 @@ enum class DebounceState {
 struct DebounceData {
     int           timeout_ms;
     int           ref_count;
-    int           time_ms;
+    TimerHandle   timer;
     DebounceState state;
 };
 
+using DebounceHandle = slot_map<DebounceData>::handle;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 struct Easer {
-    std::vector<DebounceData> debouncers;
+    // Slots are released when the last Debounce referring to them goes away,
+    // so transient debouncers do not grow this.
+    slot_map<DebounceData> debouncers;
+
+    // Running debouncers are the only things with a timer, so step only
+    // touches the debouncers that actually time out.
+    TimerWheel timers;
+
+    Tweener tweens;
 
     void step(int ms)
     {
-        for (auto& item : debouncers)
+        tweens.step(ms);
+
+        timers.advance(ms, [this](uint32 index) {
+            // A debouncer's timer is cancelled when its slot is released, so
+            // the slot is always live here.
+            auto& item = debouncers.at_index(index);
+            item.state = DebounceState::DEFAULT;
+            item.timer = {};
+        });
+    }
+
+    // Time left before the debouncer returns to its default state.
+    auto remaining_ms(DebounceData const& item) const -> int
+    {
+        if (item.state == DebounceState::DEFAULT)
         {
-            if (item.state != DebounceState::DEFAULT)
-            {
-                item.time_ms -= ms;
-                if (item.time_ms <= 0)
-                {
-                    item.state = DebounceState::DEFAULT;
-                }
-            }
+            return 0;
         }
+        return static_cast<int>(timers.expiry(item.timer) - timers.now());
     }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Shared owner of a debouncer slot in an Easer. Copies share the slot; the
+// slot (and any running timer) is released when the last copy is destroyed.
+// The Easer must outlive every Debounce made from it.
 struct Debounce {
     // Ctor
-    Debounce(vecref<DebounceData> item)
-        : ref(item)
+    Debounce(Easer& easer, DebounceHandle handle)
+        : easer(&easer)
+        , id(handle)
     {
-        ++ref_count();
+        acquire();
     }
 
     // Dtor
     ~Debounce()
     {
-        --ref_count();
+        release();
     }
 
     // Copy
     Debounce(Debounce const& other)
-        : ref(other.ref)
+        : easer(other.easer)
+        , id(other.id)
     {
-        ++ref_count();
+        acquire();
     }
     auto operator=(Debounce const& other) -> Debounce&
     {
-        ref = other.ref;
-        ++ref_count();
+        if (this != &other)
+        {
+            // Acquire before releasing in case both refer to the same slot.
+            Debounce tmp(other);
+            swap(tmp);
+        }
         return *this;
     }
 
-    // Move - deleted as same as copy construction.
-    Debounce(Debounce&& other) = delete;
-    auto operator=(Debounce&& other) -> Debounce& = delete;
+    // Move - the moved from debounce no longer owns a slot.
+    Debounce(Debounce&& other) noexcept
+        : easer(other.easer)
+        , id(other.id)
+    {
+        other.easer = nullptr;
+    }
+    auto operator=(Debounce&& other) noexcept -> Debounce&
+    {
+        if (this != &other)
+        {
+            release();
+            easer       = other.easer;
+            id          = other.id;
+            other.easer = nullptr;
+        }
+        return *this;
+    }
+
+    void swap(Debounce& other) noexcept
+    {
+        std::swap(easer, other.easer);
+        std::swap(id, other.id);
+    }
 
     // Accessors
+    auto handle() const noexcept -> DebounceHandle { return id; }
+
     auto get() -> bool
     {
-        auto& data = ref.get();
+        if (!easer)
+        {
+            return false;
+        }
+
+        auto& data = easer->debouncers.at(id);
         switch (data.state)
         {
         case DebounceState::RUNNING: {
@@ -93,17 +150,17 @@ struct Debounce {
     // Modifiers
     auto set(bool value) -> bool
     {
-        if (!value)
+        if (!value || !easer)
         {
             return false;
         }
 
-        auto& data = ref.get();
+        auto& data = easer->debouncers.at(id);
         switch (data.state)
         {
         case DebounceState::DEFAULT: {
-            data.state   = DebounceState::RUNNING;
-            data.time_ms = data.timeout_ms;
+            data.state = DebounceState::RUNNING;
+            data.timer = easer->timers.schedule(data.timeout_ms, id.index);
             return true;
         }
         default: {
@@ -113,16 +170,34 @@ struct Debounce {
     }
 
 private:
-    // You must never take a persistent copy of the reference as it
-    // points to element in a vector which can resize.
-    int& ref_count()
+    void acquire()
+    {
+        if (easer)
+        {
+            easer->debouncers.at(id).ref_count += 1;
+        }
+    }
+
+    void release() noexcept
     {
-        auto& data = ref.get();
-        return data.ref_count;
+        if (!easer || !easer->debouncers.contains(id))
+        {
+            return;
+        }
+
+        auto& data = easer->debouncers.at(id);
+        data.ref_count -= 1;
+        if (data.ref_count <= 0)
+        {
+            easer->timers.cancel(data.timer);
+            easer->debouncers.erase(id);
+        }
+        easer = nullptr;
     }
 
 private:
-    vecref<DebounceData> ref;
+    Easer*         easer;
+    DebounceHandle id;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -132,13 +207,30 @@ inline auto make_debounce_switch(Easer& easer, int timeout_ms) -> Debounce
     DebounceData data{
         timeout_ms,
         0,
-        0,
+        {},
         DebounceState::DEFAULT};
 
-    easer.debouncers.push_back(data);
+    return {easer, easer.debouncers.insert(data)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-    auto& vec = easer.debouncers;
-    return {vecref{vec, vec.size() - 1}};
+inline void tween(Easer& easer, float* target, float to, int duration_ms, Curve curve = Curve::LINEAR)
+{
+    easer.tweens.add(target, to, duration_ms, curve);
+}
+
+// Tweens a 2d value, e.g. a position, as two channels sharing the same timing.
+inline void tween(Easer& easer,
+                  float* x,
+                  float* y,
+                  float  to_x,
+                  float  to_y,
+                  int    duration_ms,
+                  Curve  curve = Curve::LINEAR)
+{
+    easer.tweens.add(x, to_x, duration_ms, curve);
+    easer.tweens.add(y, to_y, duration_ms, curve);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
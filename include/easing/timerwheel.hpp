@@ -0,0 +1,298 @@
+#pragma once
+
+#include "typedefs.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace easing {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Identifies a scheduled timer. The generation makes cancelling a timer that
+// has already fired (and whose node has been reused) a no-op.
+struct TimerHandle {
+    uint32 index{~uint32{0}};
+    uint32 generation{};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Hierarchical timer wheel with a 1 ms tick.
+//
+// Four levels of 64 slots cover 2^24 ms (~4.6 hours); longer timers are parked
+// in the last level and re-filed as the wheel turns. Scheduling and cancelling
+// are O(1). Advancing only visits the slots that are due, skipping runs of
+// empty level 0 slots using the occupancy mask, and higher levels are cascaded
+// down once every 64 ticks of the level below. Expiry is therefore amortised
+// O(1) per timer and step cost does not depend on how many timers are waiting.
+//
+// Each timer carries a uint32 payload which is handed back when it expires.
+class TimerWheel {
+public:
+    static constexpr int    SLOT_BITS = 6;
+    static constexpr int    SLOTS     = 1 << SLOT_BITS;
+    static constexpr int    LEVELS    = 4;
+    static constexpr uint32 MASK      = SLOTS - 1;
+    static constexpr int64  MAX_DELAY = (int64{1} << (SLOT_BITS * LEVELS)) - 1;
+
+    TimerWheel()
+    {
+        heads.fill(NIL);
+        occupied.fill(0);
+    }
+
+    // Time, in ms, of the last processed tick.
+    auto now() const noexcept -> int64 { return current; }
+
+    // Number of timers waiting to expire.
+    auto size() const noexcept -> std::size_t { return active; }
+
+    void reserve(std::size_t n)
+    {
+        nodes.reserve(n);
+        free_nodes.reserve(n);
+        expired.reserve(n);
+    }
+
+    // Schedules payload to expire delay_ms from now. Delays of less than 1 ms
+    // expire on the next advance.
+    auto schedule(int64 delay_ms, uint32 payload) -> TimerHandle
+    {
+        uint32 index;
+        if (free_nodes.empty())
+        {
+            index = static_cast<uint32>(nodes.size());
+            nodes.push_back({});
+        }
+        else
+        {
+            index = free_nodes.back();
+            free_nodes.pop_back();
+        }
+
+        auto& node   = nodes[index];
+        node.expiry  = current + std::max<int64>(delay_ms, 1);
+        node.payload = payload;
+        node.armed   = true;
+
+        link(index);
+        active += 1;
+
+        return {index, node.generation};
+    }
+
+    // Returns false if the timer has already expired or been cancelled.
+    auto cancel(TimerHandle handle) -> bool
+    {
+        if (!is_scheduled(handle))
+        {
+            return false;
+        }
+
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    }
+
+    auto is_scheduled(TimerHandle handle) const noexcept -> bool
+    {
+        return (handle.index < nodes.size())
+               && nodes[handle.index].armed
+               && (nodes[handle.index].generation == handle.generation);
+    }
+
+    // Time, in ms, at which the timer expires.
+    auto expiry(TimerHandle handle) const noexcept -> int64
+    {
+        return is_scheduled(handle) ? nodes[handle.index].expiry : current;
+    }
+
+    // Advances the wheel by ms and calls on_expired(payload) for every timer
+    // that expires, in expiry order. The callback may schedule or cancel
+    // timers.
+    template <typename Fn>
+    void advance(int64 ms, Fn&& on_expired)
+    {
+        int64 const target = current + std::max<int64>(ms, 0);
+
+        while (current < target)
+        {
+            if (active == 0)
+            {
+                current = target;
+                break;
+            }
+
+            int64 const  tick  = current + 1;
+            uint32 const index = static_cast<uint32>(tick) & MASK;
+
+            if (index == 0)
+            {
+                cascade(tick);
+            }
+            else if ((occupied[0] >> index) == 0)
+            {
+                // Nothing left in level 0 before it wraps, so jump to the
+                // next cascade point (or the target, if that is sooner).
+                current = std::min(tick | MASK, target);
+                continue;
+            }
+
+            current = tick;
+            collect(index);
+
+            for (auto payload : expired)
+            {
+                on_expired(payload);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32 NIL = ~uint32{0};
+
+    struct Node {
+        int64  expiry{};
+        uint32 payload{};
+        uint32 generation{};
+        uint32 next{NIL};
+        uint32 prev{NIL};
+        uint32 slot{NIL};
+        bool   armed{};
+    };
+
+    // Files the node into the slot for its expiry, relative to the next tick
+    // to be processed.
+    void link(uint32 index)
+    {
+        auto&       node  = nodes[index];
+        int64 const base  = current + 1;
+        int64 const delta = std::min(node.expiry - base, MAX_DELAY);
+        int64 const when  = base + std::max<int64>(delta, 0);
+
+        int level = 0;
+        while ((level < LEVELS - 1) && (delta >= (int64{1} << (SLOT_BITS * (level + 1)))))
+        {
+            level += 1;
+        }
+
+        uint32 const slot_in_level = static_cast<uint32>(when >> (SLOT_BITS * level)) & MASK;
+        uint32 const slot          = (level * SLOTS) + slot_in_level;
+
+        node.slot = slot;
+        node.prev = NIL;
+        node.next = heads[slot];
+        if (node.next != NIL)
+        {
+            nodes[node.next].prev = index;
+        }
+        heads[slot] = index;
+        occupied[level] |= (uint64{1} << slot_in_level);
+    }
+
+    void unlink(uint32 index)
+    {
+        auto& node = nodes[index];
+
+        if (node.prev != NIL)
+        {
+            nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            heads[node.slot] = node.next;
+        }
+
+        if (node.next != NIL)
+        {
+            nodes[node.next].prev = node.prev;
+        }
+
+        if (heads[node.slot] == NIL)
+        {
+            occupied[node.slot / SLOTS] &= ~(uint64{1} << (node.slot & MASK));
+        }
+
+        node.next = NIL;
+        node.prev = NIL;
+        node.slot = NIL;
+    }
+
+    void release(uint32 index)
+    {
+        auto& node = nodes[index];
+        node.armed = false;
+        node.generation += 1;
+        free_nodes.push_back(index);
+        active -= 1;
+    }
+
+    // Moves every timer in the higher level slots that are now due down a
+    // level. Called when level 0 wraps.
+    void cascade(int64 tick)
+    {
+        // current is tick - 1 here, so nodes are re-filed relative to the
+        // tick being processed.
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            uint32 const slot_in_level = static_cast<uint32>(tick >> (SLOT_BITS * level)) & MASK;
+            uint32 const slot          = (level * SLOTS) + slot_in_level;
+
+            uint32 index = heads[slot];
+            heads[slot]  = NIL;
+            occupied[level] &= ~(uint64{1} << slot_in_level);
+
+            while (index != NIL)
+            {
+                uint32 const next = nodes[index].next;
+                link(index);
+                index = next;
+            }
+
+            if (slot_in_level != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Detaches and releases every node in the level 0 slot. Payloads are
+    // gathered first so callbacks can safely schedule into the same slot.
+    void collect(uint32 slot)
+    {
+        expired.clear();
+
+        uint32 index = heads[slot];
+        heads[slot]  = NIL;
+        occupied[0] &= ~(uint64{1} << slot);
+
+        while (index != NIL)
+        {
+            auto& node = nodes[index];
+
+            uint32 const next = node.next;
+            expired.push_back(node.payload);
+
+            node.next = NIL;
+            node.prev = NIL;
+            node.slot = NIL;
+            release(index);
+
+            index = next;
+        }
+    }
+
+private:
+    std::vector<Node>                  nodes;
+    std::vector<uint32>                free_nodes;
+    std::vector<uint32>                expired;
+    std::array<uint32, LEVELS * SLOTS> heads;
+    std::array<uint64, LEVELS>         occupied;
+    int64                              current{};
+    std::size_t                        active{};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
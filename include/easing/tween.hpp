@@ -0,0 +1,375 @@
+#pragma once
+
+#include "typedefs.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace easing {
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class Curve : uint8 {
+    LINEAR,
+    QUAD_IN,
+    QUAD_OUT,
+    QUAD_IN_OUT,
+    CUBIC_IN,
+    CUBIC_OUT,
+    CUBIC_IN_OUT,
+    SINE_IN_OUT,
+    BACK_OUT,
+    ELASTIC_OUT,
+    // Decaying oscillation that ends where it started, e.g. for camera
+    // shake. The amplitude is the tween's change, to - start, so shaking by
+    // 5 from 0 is a tween to 5.
+    SHAKE,
+    COUNT
+};
+
+constexpr int CURVE_COUNT   = static_cast<int>(Curve::COUNT);
+constexpr int CURVE_SAMPLES = 256;
+
+using CurveTable = std::array<float, CURVE_SAMPLES + 1>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline auto evaluate_curve(Curve curve, float t) -> float
+{
+    constexpr float pi = 3.14159265358979f;
+
+    switch (curve)
+    {
+    case Curve::LINEAR:
+        return t;
+    case Curve::QUAD_IN:
+        return t * t;
+    case Curve::QUAD_OUT:
+        return t * (2.f - t);
+    case Curve::QUAD_IN_OUT:
+        return (t < 0.5f) ? (2.f * t * t) : (-1.f + ((4.f - (2.f * t)) * t));
+    case Curve::CUBIC_IN:
+        return t * t * t;
+    case Curve::CUBIC_OUT: {
+        float u = t - 1.f;
+        return (u * u * u) + 1.f;
+    }
+    case Curve::CUBIC_IN_OUT: {
+        if (t < 0.5f)
+        {
+            return 4.f * t * t * t;
+        }
+        float u = (2.f * t) - 2.f;
+        return (0.5f * u * u * u) + 1.f;
+    }
+    case Curve::SINE_IN_OUT:
+        return 0.5f * (1.f - std::cos(pi * t));
+    case Curve::BACK_OUT: {
+        constexpr float s = 1.70158f;
+        float           u = t - 1.f;
+        return (u * u * (((s + 1.f) * u) + s)) + 1.f;
+    }
+    case Curve::ELASTIC_OUT: {
+        if (t <= 0.f || t >= 1.f)
+        {
+            return t;
+        }
+        return (std::pow(2.f, -10.f * t) * std::sin((t - 0.075f) * (2.f * pi) / 0.3f)) + 1.f;
+    }
+    case Curve::SHAKE:
+        return std::sin(t * pi * 8.f) * (1.f - t);
+    default:
+        return t;
+    }
+}
+
+// Curves are sampled once into lookup tables. Evaluating a tween is then a
+// table lookup and a lerp regardless of which curve it uses.
+inline auto curve_tables() -> std::array<CurveTable, CURVE_COUNT> const&
+{
+    static auto const tables = [] {
+        std::array<CurveTable, CURVE_COUNT> result;
+        for (int c = 0; c < CURVE_COUNT; ++c)
+        {
+            for (int i = 0; i <= CURVE_SAMPLES; ++i)
+            {
+                float t      = static_cast<float>(i) / CURVE_SAMPLES;
+                result[c][i] = evaluate_curve(static_cast<Curve>(c), t);
+            }
+        }
+        return result;
+    }();
+    return tables;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Animates floats towards target values.
+//
+// Tweens are stored as structure of arrays and advanced together in step():
+// one pass updates progress, one samples the curves and one writes the values
+// out. The progress pass has no branches or calls so the compiler can
+// vectorise it. Finished tweens are swap removed. Each target's slot is kept
+// in a flat hash table so retargeting and cancelling do not search, and once
+// reserve() has sized everything adding and removing tweens never allocates.
+struct Tweener {
+    std::vector<float*> targets;
+    std::vector<float>  from;
+    std::vector<float>  delta;
+    std::vector<float>  elapsed_ms;
+    std::vector<float>  inv_duration;
+    std::vector<uint8>  curves;
+
+    auto size() const noexcept -> std::size_t { return targets.size(); }
+
+    void reserve(std::size_t n)
+    {
+        targets.reserve(n);
+        from.reserve(n);
+        delta.reserve(n);
+        elapsed_ms.reserve(n);
+        inv_duration.reserve(n);
+        curves.reserve(n);
+        progress.reserve(n);
+
+        if (slot_table.size() < 2 * n)
+        {
+            rebuild_slots(2 * n);
+        }
+    }
+
+    // Starts tweening target from its current value to `to`. A target that is
+    // already tweening is retargeted from where it currently is.
+    void add(float* target, float to, int duration_ms, Curve curve = Curve::LINEAR)
+    {
+        add(target, *target, to, duration_ms, curve);
+    }
+
+    void add(float* target, float start, float to, int duration_ms, Curve curve = Curve::LINEAR)
+    {
+        cancel(target);
+
+        if (2 * (targets.size() + 1) > slot_table.size())
+        {
+            rebuild_slots(4 * (targets.size() + 1));
+        }
+
+        insert_slot(target, targets.size());
+        targets.push_back(target);
+        from.push_back(start);
+        delta.push_back(to - start);
+        elapsed_ms.push_back(0.f);
+        inv_duration.push_back(1.f / static_cast<float>(std::max(duration_ms, 1)));
+        curves.push_back(static_cast<uint8>(curve));
+        progress.push_back(0.f);
+
+        *target = start;
+    }
+
+    // Stops tweening target, leaving it at its current value.
+    auto cancel(float const* target) -> bool
+    {
+        std::size_t const at = find_slot(target);
+        if (at == NO_SLOT)
+        {
+            return false;
+        }
+
+        remove(slot_table[at].slot);
+        return true;
+    }
+
+    void clear()
+    {
+        targets.clear();
+        from.clear();
+        delta.clear();
+        elapsed_ms.clear();
+        inv_duration.clear();
+        curves.clear();
+        progress.clear();
+        std::fill(slot_table.begin(), slot_table.end(), SlotEntry{});
+    }
+
+    void step(int ms)
+    {
+        std::size_t const n = targets.size();
+        if (n == 0)
+        {
+            return;
+        }
+
+        float const dt     = static_cast<float>(ms);
+        auto const& tables = curve_tables();
+
+        float* __restrict e = elapsed_ms.data();
+        float* __restrict p = progress.data();
+        float const* inv    = inv_duration.data();
+        float const* f      = from.data();
+        float const* d      = delta.data();
+
+        // Progress through each tween, 0 -> 1.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            e[i] += dt;
+            p[i] = std::min(e[i] * inv[i], 1.f);
+        }
+
+        // Sample the curves. Progress is overwritten with the eased value.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const& table = tables[curves[i]];
+
+            float x    = p[i] * CURVE_SAMPLES;
+            int   k    = std::min(static_cast<int>(x), CURVE_SAMPLES - 1);
+            float frac = x - static_cast<float>(k);
+            p[i]       = table[k] + ((table[k + 1] - table[k]) * frac);
+        }
+
+        // Write the values out.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            *targets[i] = f[i] + (d[i] * p[i]);
+        }
+
+        // Remove finished tweens, back to front so swaps only move tweens that
+        // have already been checked.
+        for (std::size_t i = n; i-- > 0;)
+        {
+            if (e[i] * inv[i] >= 1.f)
+            {
+                // Land exactly on the curve's end value.
+                *targets[i] = f[i] + (d[i] * tables[curves[i]][CURVE_SAMPLES]);
+                remove(i);
+            }
+        }
+    }
+
+private:
+    void remove(std::size_t i)
+    {
+        std::size_t const back = targets.size() - 1;
+
+        erase_slot(targets[i]);
+        if (i != back)
+        {
+            slot_table[find_slot(targets[back])].slot = static_cast<uint32>(i);
+        }
+
+        targets[i]      = targets[back];
+        from[i]         = from[back];
+        delta[i]        = delta[back];
+        elapsed_ms[i]   = elapsed_ms[back];
+        inv_duration[i] = inv_duration[back];
+        curves[i]       = curves[back];
+        progress[i]     = progress[back];
+
+        targets.pop_back();
+        from.pop_back();
+        delta.pop_back();
+        elapsed_ms.pop_back();
+        inv_duration.pop_back();
+        curves.pop_back();
+        progress.pop_back();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Target to slot table: open addressed with linear probing, a power of two
+    // in size and never more than half full.
+
+    struct SlotEntry {
+        float const* target{}; // nullptr for an empty entry.
+        uint32       slot{};
+    };
+
+    static constexpr std::size_t NO_SLOT = ~std::size_t{0};
+
+    auto home(float const* target) const noexcept -> std::size_t
+    {
+        // Fibonacci hashing, the high bits of the product are the well mixed
+        // ones.
+        auto const key = static_cast<uint64>(reinterpret_cast<std::uintptr_t>(target));
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> 32) & (slot_table.size() - 1);
+    }
+
+    auto find_slot(float const* target) const noexcept -> std::size_t
+    {
+        if (slot_table.empty())
+        {
+            return NO_SLOT;
+        }
+
+        std::size_t const mask = slot_table.size() - 1;
+        for (std::size_t at = home(target); slot_table[at].target != nullptr; at = (at + 1) & mask)
+        {
+            if (slot_table[at].target == target)
+            {
+                return at;
+            }
+        }
+        return NO_SLOT;
+    }
+
+    // target must not be in the table.
+    void insert_slot(float const* target, std::size_t slot)
+    {
+        std::size_t const mask = slot_table.size() - 1;
+
+        std::size_t at = home(target);
+        while (slot_table[at].target != nullptr)
+        {
+            at = (at + 1) & mask;
+        }
+        slot_table[at] = SlotEntry{target, static_cast<uint32>(slot)};
+    }
+
+    // Shifts the entries after target back over the hole, so no tombstones
+    // build up as tweens come and go.
+    void erase_slot(float const* target)
+    {
+        std::size_t const mask = slot_table.size() - 1;
+
+        std::size_t hole = find_slot(target);
+        for (std::size_t at = (hole + 1) & mask; slot_table[at].target != nullptr; at = (at + 1) & mask)
+        {
+            // Entries whose home is after the hole, cyclically, stay put.
+            std::size_t const from_home = (at - home(slot_table[at].target)) & mask;
+            std::size_t const from_hole = (at - hole) & mask;
+            if (from_home >= from_hole)
+            {
+                slot_table[hole] = slot_table[at];
+                hole             = at;
+            }
+        }
+        slot_table[hole] = SlotEntry{};
+    }
+
+    // Resizes the table to hold at least `entries` and refills it from targets.
+    void rebuild_slots(std::size_t entries)
+    {
+        std::size_t size = 16;
+        while (size < entries)
+        {
+            size *= 2;
+        }
+
+        slot_table.assign(size, SlotEntry{});
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            insert_slot(targets[i], i);
+        }
+    }
+
+private:
+    // Scratch space for step(), kept to avoid allocating every frame.
+    std::vector<float> progress;
+
+    // Where each target's tween is.
+    std::vector<SlotEntry> slot_table;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -4,6 +4,7 @@
 #include "recthelper.hpp"
 #include "screen.h"
 #include <SDL2/SDL.h>
+#include <cmath>
 
 namespace entity {
 
@@ -35,6 +36,11 @@ inline void integrate(Entity* e, float dt)
     e->X    = e->Xdot;
 }
 
+inline auto speed(Entity const* e) -> float
+{
+    return std::hypot(e->X[1][0], e->X[1][1]);
+}
+
 // For state(pos, vel) with 2 dimensions, X is:
 // px, py
 // vx, vy
@@ -1,4 +1,5 @@
 #pragma once
+#include "debug/counters.hpp"
 #include "entity/entity.hpp"
 #include <array>
 
@@ -71,6 +72,8 @@ inline void update(entity::Allocator& alloca)
 {
     alloca.pos.interpolated = alloca.pos.simulated;
     alloca.rot.interpolated = alloca.rot.simulated;
+
+    debug::count(debug::Counter::UPDATE_BYTES, sizeof(alloca.pos.interpolated) + sizeof(alloca.rot.interpolated));
 }
 
 } // namespace entity
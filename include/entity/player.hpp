@@ -7,6 +7,7 @@
 #include "entity/entityallocator.hpp"
 #include "linalg/matrix.hpp"
 #include "linalg/trans.hpp"
+#include <memory_resource>
 
 namespace entity {
 
@@ -193,64 +194,82 @@ inline void hit(entity::Player& player, entity::Bullet const& bullet)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Moves the bullets dt in substeps steps, removing any that hit another
+// player or a wall at any step, then any that left the screen. Scratch lists
+// come from scratch, e.g. the tick's frame_arena.
 inline void update_bullets(entity::Player&               player,
                            std::vector<entity::Player>&  players,
                            std::vector<SDL_FRect> const& hard_entities,
                            SDL_Rect const&               screen_rect,
-                           float                         dt)
+                           float                         dt,
+                           int                           substeps = 1,
+                           std::pmr::memory_resource*    scratch  = std::pmr::get_default_resource())
 {
     auto& bullets = player.bullets;
 
-    // Update the bullet positions.
-    //
-    for (auto& bullet : player.bullets)
-    {
-        integrate(bullet, dt);
-    }
+    // Never more than the bullets, so it is only allocated once.
+    std::pmr::vector<std::size_t> indices(scratch);
+    indices.reserve(bullets.max_size());
 
-    // Check if bullets have hit any of the other players.
-    //
-    for (auto& other_player : players)
+    float const dt_step = dt / substeps;
+
+    for (int step = 0; step < substeps; ++step)
     {
-        if (std::addressof(player) == std::addressof(other_player))
+        // Update the bullet positions.
+        //
+        for (auto& bullet : player.bullets)
         {
-            continue;
+            integrate(bullet, dt_step);
         }
 
-        // Note(DW): Lambdas
-        // I believe this to be ok performance-wise. There is no additional overhead
-        // in comparison to a functor and is generally equivalent to calling a function.
-
-        auto collided_hard = [&other_player](Bullet const& bullet) {
-            auto center   = rect_center(bullet.s);
-            auto collided = collision::is_point_in_rect(center,
-                                                        sdl_rect(other_player.s));
-            if (collided)
+        // Check if bullets have hit any of the other players.
+        //
+        for (auto& other_player : players)
+        {
+            if (std::addressof(player) == std::addressof(other_player))
             {
-                hit(other_player, bullet);
+                continue;
             }
-            return collided;
-        };
-
 
-        auto indices = algorithm::find_indices(bullets, collided_hard);
-        bullets.remove(indices);
-    }
-
-    // Check if the bullets have hit any walls.
-    //
-    for (auto const& hard_entity : hard_entities)
-    {
-        // See Note(DW): Lambdas
-        auto collided_hard = [&hard_entity](Bullet const& bullet) {
-            auto& pX = bullet.s->X;
-
-            linalg::Vectorf<2> origin{{pX[0][0], pX[0][1]}};
-            return collision::is_point_in_rect(origin, hard_entity);
-        };
+            // Note(DW): Lambdas
+            // I believe this to be ok performance-wise. There is no additional overhead
+            // in comparison to a functor and is generally equivalent to calling a function.
+
+            auto collided_hard = [&other_player](Bullet const& bullet) {
+                auto center   = rect_center(bullet.s);
+                auto collided = collision::is_point_in_rect(center,
+                                                            sdl_rect(other_player.s));
+                if (collided)
+                {
+                    hit(other_player, bullet);
+                }
+                return collided;
+            };
+
+
+            algorithm::find_indices(bullets, collided_hard, indices);
+            debug::count(debug::Counter::COLLISION_CANDIDATES, bullets.size());
+            debug::count(debug::Counter::COLLISION_HITS, indices.size());
+            bullets.remove(indices);
+        }
 
-        auto indices = algorithm::find_indices(bullets, collided_hard);
-        bullets.remove(indices);
+        // Check if the bullets have hit any walls.
+        //
+        for (auto const& hard_entity : hard_entities)
+        {
+            // See Note(DW): Lambdas
+            auto collided_hard = [&hard_entity](Bullet const& bullet) {
+                auto& pX = bullet.s->X;
+
+                linalg::Vectorf<2> origin{{pX[0][0], pX[0][1]}};
+                return collision::is_point_in_rect(origin, hard_entity);
+            };
+
+            algorithm::find_indices(bullets, collided_hard, indices);
+            debug::count(debug::Counter::COLLISION_CANDIDATES, bullets.size());
+            debug::count(debug::Counter::COLLISION_HITS, indices.size());
+            bullets.remove(indices);
+        }
     }
 
     // Check if the bullets have left the screen.
@@ -260,29 +279,25 @@ inline void update_bullets(entity::Player&               player,
         return !collision::is_point_in_rect(center, screen_rect);
     };
 
-    auto indices = algorithm::find_indices(bullets, left_screen);
+    algorithm::find_indices(bullets, left_screen, indices);
     bullets.remove(indices);
 }
 
 
-inline void update_crosshair(entity::Player& player)
+// Places the crosshair rect ch a fixed distance from the body's center, in
+// the direction of aim.
+inline void place_crosshair(SDL_FRect&                    ch,
+                            entity::Entity const&         body,
+                            entity::EntityRotation const& aim)
 {
-    // This function places the crosshair.
-    // This requires the player's current position, the player's aim and
-    // a vector that places the crosshair at some length away from the
-    // player.
-    SDL_FRect& ch = player.crosshair.rect;
-
     // Move the crosshair to the center of the player.
-    //center_on_center(ch, player.r);
-
-    auto player_center = rect_center(player.r);
+    auto player_center = rect_center(body);
     ch.x               = player_center[0] - (ch.w / 2.f);
     ch.y               = player_center[1] - (ch.h / 2.f);
 
     // Create a vector rotated by the player's aim.
     linalg::Vectorf<2> m{{80, 0}};
-    auto&              Y = player.aim.r->X;
+    auto const&        Y = aim.X;
 
     m = lrotzf(Y[0]) * m;
 
@@ -290,6 +305,15 @@ inline void update_crosshair(entity::Player& player)
     ch.x += m[0];
     ch.y += m[1];
 }
+
+inline void update_crosshair(entity::Player& player)
+{
+    // This function places the crosshair.
+    // This requires the player's current position, the player's aim and
+    // a vector that places the crosshair at some length away from the
+    // player.
+    place_crosshair(player.crosshair.rect, *player.r, *player.aim.r);
+}
 }
 
 namespace std {
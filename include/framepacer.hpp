@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Picks how many base periods a frame gets from what frames cost. A frame
+// that takes most of its period doubles up to the next slower rate straight
+// away; going back to a faster rate waits until frames have been comfortably
+// cheap for a while, so the rate does not flap at the boundary.
+struct RateAdapter {
+    static constexpr int MAX_DIVISOR  = 4;
+    static constexpr int CALM_FRAMES  = 60;
+    static constexpr double SLOW_DOWN = 0.9; // Of the current period.
+    static constexpr double SPEED_UP  = 0.6; // Of the next faster period.
+
+    int    divisor{1};
+    int    calm_frames{};
+    double cost{}; // Smoothed, seconds.
+
+    // Returns the divisor for the next frame.
+    auto update(double frame_cost, double base_period) -> int
+    {
+        cost = (cost == 0.0) ? frame_cost : (cost * 0.9) + (frame_cost * 0.1);
+
+        if ((cost > (SLOW_DOWN * base_period * divisor)) && (divisor < MAX_DIVISOR))
+        {
+            ++divisor;
+            calm_frames = 0;
+        }
+        else if ((divisor > 1) && (cost < (SPEED_UP * base_period * (divisor - 1))))
+        {
+            if (++calm_frames >= CALM_FRAMES)
+            {
+                --divisor;
+                calm_frames = 0;
+            }
+        }
+        else
+        {
+            calm_frames = 0;
+        }
+
+        return divisor;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Paces the main loop to a target frame rate.
+//
+// Waiting sleeps until shortly before the deadline and spins for the rest, so
+// frames start on time without burning a core. The spin margin follows how
+// late sleeps actually wake up. With vsync the present already waits, so the
+// pacer only measures.
+//
+// Frames that overrun start the next one straight away, the schedule is not
+// caught up with a burst of short frames. The frame rate steps down to a
+// fraction of the target when frames keep overrunning, see RateAdapter.
+//
+// Usage, once per frame:
+//   dt = pacer.begin_frame();
+//   ... update, render ...
+//   pacer.begin_present();
+//   SDL_RenderPresent(renderer);
+//   pacer.end_frame();
+class FramePacer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Totals over the last whole second, in seconds.
+    struct Report {
+        int    frames{};
+        double work{};    // begin_frame to begin_present.
+        double present{}; // begin_present to end_frame.
+        double idle{};    // Asleep waiting for the next frame.
+        double spin{};    // Awake waiting for the next frame.
+
+        auto frame_ms() const -> float
+        {
+            return (frames > 0) ? static_cast<float>(((work + present) * 1000) / frames) : 0.f;
+        }
+
+        auto idle_percent() const -> float
+        {
+            double const total = work + present + idle + spin;
+            return (total > 0) ? static_cast<float>((idle * 100) / total) : 0.f;
+        }
+    };
+
+    explicit FramePacer(double target_hz = 60.0, bool vsync = false)
+        : base_period(1.0 / target_hz)
+        , vsync(vsync)
+    {
+        frame_start  = clock::now();
+        deadline     = frame_start;
+        report_start = frame_start;
+    }
+
+    // Starts a frame. Returns the seconds since the last frame started.
+    auto begin_frame() -> double
+    {
+        auto const now = clock::now();
+        double const dt = seconds(now - frame_start);
+        frame_start     = now;
+        return dt;
+    }
+
+    void begin_present() { present_start = clock::now(); }
+
+    // Ends the frame and waits until the next one is due.
+    void end_frame()
+    {
+        auto const now = clock::now();
+
+        double const work    = seconds(present_start - frame_start);
+        double const present = seconds(now - present_start);
+
+        current.work += work;
+        current.present += present;
+        ++current.frames;
+
+        if (vsync)
+        {
+            deadline = now;
+        }
+        else
+        {
+            int const divisor = adapter.update(work + present, base_period);
+
+            deadline += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(base_period * divisor));
+            if (deadline < now)
+            {
+                deadline = now;
+            }
+
+            wait_until(deadline);
+        }
+
+        auto const end = clock::now();
+        if ((end - report_start) >= std::chrono::seconds(1))
+        {
+            last         = current;
+            current      = {};
+            report_start = end;
+        }
+    }
+
+    auto report() const noexcept -> Report const& { return last; }
+    auto period() const noexcept -> double { return base_period * adapter.divisor; }
+    auto spin_margin() const noexcept -> double { return margin; }
+
+private:
+    static auto seconds(clock::duration d) -> double { return std::chrono::duration<double>(d).count(); }
+
+    void wait_until(clock::time_point target)
+    {
+        auto now = clock::now();
+
+        auto const sleep_margin = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(margin));
+        if ((target - now) > sleep_margin)
+        {
+            auto const wake = target - sleep_margin;
+            std::this_thread::sleep_until(wake);
+
+            auto const woke = clock::now();
+            current.idle += seconds(woke - now);
+
+            // Keep the margin at about twice the usual lateness.
+            double const late = std::max(0.0, seconds(woke - wake));
+            margin            = std::clamp((margin * 0.9) + (late * 2 * 0.1), MIN_MARGIN, MAX_MARGIN);
+
+            now = woke;
+        }
+
+        auto const spin_start = now;
+        while (now < target)
+        {
+            std::this_thread::yield();
+            now = clock::now();
+        }
+        current.spin += seconds(now - spin_start);
+    }
+
+private:
+    static constexpr double MIN_MARGIN = 0.00025;
+    static constexpr double MAX_MARGIN = 0.003;
+
+    double base_period;
+    bool   vsync;
+    double margin{0.001};
+
+    RateAdapter adapter;
+
+    clock::time_point frame_start;
+    clock::time_point present_start;
+    clock::time_point deadline;
+    clock::time_point report_start;
+
+    Report current;
+    Report last;
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@ struct DevOptions {
     bool display_hud{};
     bool draw_vectors{};
     bool draw_minkowski{};
+    bool export_trace{}; // Set for one frame to write the profile trace.
 
     MSGPACK_DEFINE(draw_vectors, draw_minkowski);
 };
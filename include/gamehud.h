@@ -1,6 +1,7 @@
 #ifndef GAME_HUD_H
 #define GAME_HUD_H
 
+#include "drawing/hudtarget.hpp"
 #include "entity/core.hpp"
 #include "gameevents.h"
 #include "kiss_sdl.h"
@@ -21,6 +22,9 @@ struct GameHud {
     // kiss_label        labels[7]      = {0};
     kiss_progressbar hunger_bar = {0};
 
+    // Set when a widget changed since the hud was last rendered.
+    bool dirty = true;
+
     // In preperation that the positioning of the widgets could be refactored.
     int border;
     int x_offset;
@@ -84,22 +88,35 @@ struct GameHud {
     {
     }
 
-    void update(entity::Player& player)
+    void update(float health)
     {
-        hunger_bar.fraction = player.health;
+        if (hunger_bar.fraction != health)
+        {
+            hunger_bar.fraction = health;
+            dirty               = true;
+        }
     }
 
-
-    void render(SDL_Renderer* renderer, SDL_Texture* texture)
+    // Renders into target, which is retained between calls, only if
+    // something changed. Pass force to redraw anyway, e.g. when the texture's
+    // contents were lost. Returns true if anything was drawn.
+    auto render(SDL_Renderer* renderer, drawing::HudTarget const& target, bool force = false) -> bool
     {
-        SDL_SetRenderTarget(renderer, texture);
+        if (!dirty && !force)
+        {
+            return false;
+        }
+        dirty = false;
+
+        target.begin(renderer);
         SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0x00);
         SDL_RenderClear(renderer);
 
         kiss_window_draw(&window, renderer);
         kiss_progressbar_draw(&hunger_bar, renderer);
 
-        SDL_SetRenderTarget(renderer, nullptr);
+        target.end(renderer);
+        return true;
     }
 };
 
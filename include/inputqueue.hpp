@@ -0,0 +1,86 @@
+#pragma once
+
+#include "containers/spsc_ring.hpp"
+#include "typedefs.h"
+#include <chrono>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Keys the simulation reads. The main thread queues their presses and
+// releases with the time they were seen, and each tick applies the ones that
+// happened before it. A burst of catch-up ticks then sees input change part
+// way through, and a tap shorter than a tick still reaches one.
+
+enum class Key : uint8 {
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+    CLOCKWISE,
+    COUNTER_CLOCKWISE,
+    FIRE,
+};
+
+struct InputEvent {
+    uint64 time; // See input_time().
+    Key    key;
+    bool   down;
+};
+
+// Far more events than arrive between two ticks.
+using InputQueue = spsc_ring<InputEvent, 256>;
+
+// Nanoseconds on the steady clock, the time base of input events.
+inline auto input_time(std::chrono::steady_clock::time_point point) -> uint64
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(point.time_since_epoch()).count());
+}
+
+inline auto input_time() -> uint64 { return input_time(std::chrono::steady_clock::now()); }
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Key state as of a point in time, built up from queued events.
+struct KeySampler {
+    uint8 held{};    // Down at the end of the last sample.
+    uint8 pressed{}; // Went down during the last sample.
+
+    // Applies every queued event up to and including until. Later events stay
+    // queued for the next sample. Returns the time of the first event applied,
+    // or 0 if there were none.
+    auto sample(InputQueue& queue, uint64 until) -> uint64
+    {
+        uint64 first = 0;
+        pressed      = 0;
+
+        for (InputEvent const* event = queue.front(); (event != nullptr) && (event->time <= until); event = queue.front())
+        {
+            uint8 const bit = bit_of(event->key);
+            if (event->down)
+            {
+                held |= bit;
+                pressed |= bit;
+            }
+            else
+            {
+                held &= static_cast<uint8>(~bit);
+            }
+
+            if (first == 0)
+            {
+                first = event->time;
+            }
+            queue.pop();
+        }
+
+        return first;
+    }
+
+    // Held now, or pressed and released again within the last sample.
+    auto down(Key key) const -> bool { return ((held | pressed) & bit_of(key)) != 0; }
+
+private:
+    static constexpr auto bit_of(Key key) -> uint8 { return static_cast<uint8>(1u << static_cast<uint8>(key)); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -1,10 +1,12 @@
 #ifndef PROPERTY_EDITOR_HPP
 #define PROPERTY_EDITOR_HPP
 
+#include "drawing/hudtarget.hpp"
 #include "fmt/core.h"
 #include "kiss_sdl.h"
 #include <SDL2/SDL.h>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <tuple>
@@ -46,6 +48,11 @@ struct VariadicDataEditor<std::tuple<const char*, Tp*>, Args...> {
     kiss_label                        label_widget;
     decltype(associated_widget(data)) data_widget;
 
+    // The row's area in the editor window, cleared when only this row is
+    // redrawn.
+    SDL_Rect row_rect{};
+    bool     dirty{true};
+
     VariadicDataEditor<Args...> args;
 
     VariadicDataEditor(std::tuple<const char*, Tp*> tup, const Args&... args)
@@ -116,6 +123,14 @@ struct Grid2x2 {
         y = y_offset + (row * row_height);
     }
 
+    auto row_rect(kiss_window const* window) const -> SDL_Rect
+    {
+        return {x_offset,
+                y_offset + (row * row_height),
+                window->rect.w - (2 * border),
+                row_height};
+    }
+
     int row{0};
 
     int border;
@@ -235,6 +250,8 @@ template <typename Tp, typename... Args>
 auto window_init(GenericWindowArgs<Tp*, Args...>& ds, kiss_window* window, Grid2x2& grid)
 {
     init(window, grid, ds);
+    ds.row_rect = grid.row_rect(window);
+    ds.dirty    = true;
     grid.row += 1;
 
     if constexpr (sizeof...(Args) > 0)
@@ -286,54 +303,66 @@ auto window_draw(GenericWindowArgs<Tp, Args...>& ds, SDL_Renderer* renderer)
     }
 }
 
+template <typename Tp, typename... Args>
+auto window_mark_clean(GenericWindowArgs<Tp, Args...>& ds)
+{
+    ds.dirty = false;
+
+    if constexpr (sizeof...(Args) > 0)
+    {
+        window_mark_clean(ds.args);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
+// Formats value into text, returning true if the text changed. Formats into
+// a stack buffer so unchanged values cost neither an allocation nor a redraw.
+template <typename Tp>
+auto set_widget_text(char* text, Tp const& value) -> bool
+{
+    char buffer[KISS_MAX_LENGTH];
+    auto result = fmt::format_to_n(buffer, KISS_MAX_LENGTH - 1, "{}", value);
+    *result.out = '\0';
+
+    if (strncmp(text, buffer, KISS_MAX_LENGTH) == 0)
+    {
+        return false;
+    }
+
+    strncpy(text, buffer, KISS_MAX_LENGTH);
+    return true;
+}
+
 template <typename... Args>
 void update(GenericWindowArgs<bool*, Args...>& ds)
 {
     auto& widget = ds.data_widget;
-    auto  data   = *ds.data;
+    int   data   = *ds.data;
 
-    widget.selected = data;
+    if (widget.selected != data)
+    {
+        widget.selected = data;
+        ds.dirty        = true;
+    }
 }
 
 template <typename... Args>
 void update(GenericWindowArgs<bool const*, Args...>& ds)
 {
-    auto& widget = ds.data_widget;
-    auto  data   = *ds.data;
-
-    auto as_string = fmt::format("{}", data);
-
-    strncpy(widget.text,
-            as_string.c_str(),
-            KISS_MAX_LENGTH);
+    ds.dirty |= set_widget_text(ds.data_widget.text, *ds.data);
 }
 
 template <typename... Args>
 void update(GenericWindowArgs<float*, Args...>& ds)
 {
-    auto& widget = ds.data_widget;
-    auto  data   = *ds.data;
-
-    auto as_string = fmt::format("{}", data);
-
-    strncpy(widget.k.text,
-            as_string.c_str(),
-            KISS_MAX_LENGTH);
+    ds.dirty |= set_widget_text(ds.data_widget.k.text, *ds.data);
 }
 
 template <typename... Args>
 void update(GenericWindowArgs<float const*, Args...>& ds)
 {
-    kiss_label& widget = ds.data_widget;
-    auto        data   = *ds.data;
-
-    auto as_string = fmt::format("{}", data);
-
-    strncpy(widget.text,
-            as_string.c_str(),
-            KISS_MAX_LENGTH);
+    ds.dirty |= set_widget_text(ds.data_widget.text, *ds.data);
 }
 
 
@@ -391,7 +420,14 @@ auto handle_event(SDL_Event* event, int* draw, GenericWindowArgs<float const*, A
 template <typename Tp, typename... Args>
 auto editor_handle_events(GenericWindowArgs<Tp, Args...>& ds, SDL_Event* event, int* draw)
 {
-    handle_event(event, draw, ds);
+    // kiss sets draw when a widget's appearance changed, e.g. focus.
+    int widget_draw = 0;
+    handle_event(event, &widget_draw, ds);
+    if (widget_draw)
+    {
+        ds.dirty = true;
+        *draw    = 1;
+    }
 
     if constexpr (sizeof...(Args) > 0)
     {
@@ -402,16 +438,78 @@ auto editor_handle_events(GenericWindowArgs<Tp, Args...>& ds, SDL_Event* event,
 ///////////////////////////////////////////////////////////////////////////////
 
 template <typename Tp, typename... Args>
-auto window_render(SDL_Renderer* renderer, SDL_Texture* texture, kiss_window* editor_window, GenericWindowArgs<Tp, Args...>& ds)
+auto window_dirty_rows(GenericWindowArgs<Tp, Args...> const& ds) -> int
+{
+    int rows = ds.dirty ? 1 : 0;
+
+    if constexpr (sizeof...(Args) > 0)
+    {
+        rows += window_dirty_rows(ds.args);
+    }
+    return rows;
+}
+
+// Redraws the rows that changed over the window background.
+template <typename Tp, typename... Args>
+auto window_draw_dirty(GenericWindowArgs<Tp, Args...>& ds, SDL_Renderer* renderer, SDL_Color bg)
+{
+    if (ds.dirty)
+    {
+        SDL_SetRenderDrawColor(renderer, bg.r, bg.g, bg.b, bg.a);
+        SDL_RenderFillRect(renderer, &ds.row_rect);
+
+        draw(renderer, ds);
+        ds.dirty = false;
+    }
+
+    if constexpr (sizeof...(Args) > 0)
+    {
+        window_draw_dirty(ds.args, renderer, bg);
+    }
+}
+
+// Renders the editor into target, which is retained between calls. Only rows
+// that changed since the last call are redrawn, and nothing is touched if no
+// rows changed. Pass force to redraw everything, e.g. when the texture's
+// contents were lost. Returns true if anything was drawn.
+template <typename Tp, typename... Args>
+auto window_render(SDL_Renderer*                   renderer,
+                   drawing::HudTarget const&       target,
+                   kiss_window*                    editor_window,
+                   GenericWindowArgs<Tp, Args...>& ds,
+                   bool                            force = false) -> bool
 {
-    SDL_SetRenderTarget(renderer, texture);
-    SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0x00);
-    SDL_RenderClear(renderer);
+    int const dirty_rows = window_dirty_rows(ds);
+    if (!force && (dirty_rows == 0))
+    {
+        return false;
+    }
+
+    target.begin(renderer);
 
-    kiss_window_draw(editor_window, renderer);
-    window_draw(ds, renderer);
+    // The window background is translucent, rows have to replace what is
+    // there rather than blend over it.
+    SDL_BlendMode blend_mode;
+    SDL_GetRenderDrawBlendMode(renderer, &blend_mode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    if (force)
+    {
+        SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0x00);
+        SDL_RenderClear(renderer);
+
+        kiss_window_draw(editor_window, renderer);
+        window_draw(ds, renderer);
+        window_mark_clean(ds);
+    }
+    else
+    {
+        window_draw_dirty(ds, renderer, editor_window->bg);
+    }
 
-    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer, blend_mode);
+    target.end(renderer);
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -4,54 +4,132 @@
 #include "fmt/core.h"
 #include "misc.hpp"
 // #include "spdlog/spdlog.h"
+#include <array>
+#include <cmath>
 #include <linalg/matrix.hpp>
 
 //////////////////////////////////////////////////////////////////////////////
 
+// Unit circle points for each segment count, computed at compile time and
+// shared by every shape with that count. Stored as separate x and y arrays so
+// transforming them is a straight loop over contiguous floats.
+
+namespace shapes_detail {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Taylor series, accurate to double precision for |x| <= pi.
+constexpr auto sin_pi(double x) -> double
+{
+    double term   = x;
+    double result = x;
+    for (int n = 1; n < 12; ++n)
+    {
+        term *= -(x * x) / ((2 * n) * ((2 * n) + 1));
+        result += term;
+    }
+    return result;
+}
+
+constexpr auto cos_pi(double x) -> double
+{
+    double term   = 1.0;
+    double result = 1.0;
+    for (int n = 1; n < 12; ++n)
+    {
+        term *= -(x * x) / (((2 * n) - 1) * (2 * n));
+        result += term;
+    }
+    return result;
+}
+
+}
+
 template <size_t NumSegments>
-auto make_circle_points(float radius) -> linalg::Matrixf<NumSegments + 2, 3>
+struct UnitCircle {
+    std::array<float, NumSegments> x;
+    std::array<float, NumSegments> y;
+};
+
+template <size_t NumSegments>
+constexpr auto make_unit_circle() -> UnitCircle<NumSegments>
 {
     static_assert(NumSegments >= 3);
-    constexpr float seg_size = (2 * M_PI / NumSegments);
 
-    linalg::Matrixf<NumSegments + 2, 3> points;
+    UnitCircle<NumSegments> circle{};
+    for (size_t i = 0; i < NumSegments; ++i)
+    {
+        // Kept within [-pi, pi] for the series.
+        double theta = (2 * shapes_detail::PI * i) / NumSegments;
+        if (theta > shapes_detail::PI)
+        {
+            theta -= 2 * shapes_detail::PI;
+        }
+
+        circle.x[i] = static_cast<float>(shapes_detail::cos_pi(theta));
+        circle.y[i] = static_cast<float>(shapes_detail::sin_pi(theta));
+    }
+    return circle;
+}
+
+template <size_t NumSegments>
+inline constexpr UnitCircle<NumSegments> UNIT_CIRCLE = make_unit_circle<NumSegments>();
 
-    float theta = 0;
+//////////////////////////////////////////////////////////////////////////////
 
-    points[0][0] = 0;
-    points[0][1] = 0;
-    points[0][2] = 1;
+// x' = a x + b y + tx
+// y' = c x + d y + ty
+struct Affine {
+    float a, b, c, d;
+    float tx, ty;
+};
+
+// Scales by radius, rotates by theta and moves to (x, y).
+inline auto shape_affine(float radius, float theta, float x, float y) -> Affine
+{
+    float const rc = radius * std::cos(theta);
+    float const rs = radius * std::sin(theta);
+    return {rc, -rs, rs, rc, x, y};
+}
 
-    for (int i = 1; i < NumSegments + 2; ++i)
+// Transforms n points. The arrays must not overlap; there are no calls or
+// branches in the loop so it vectorises.
+inline void affine_points(float const* __restrict ux,
+                          float const* __restrict uy,
+                          size_t                  n,
+                          Affine const&           m,
+                          float* __restrict       ox,
+                          float* __restrict       oy)
+{
+    for (size_t i = 0; i < n; ++i)
     {
-        points[i][0] = cos(theta) * radius;
-        points[i][1] = sin(theta) * radius;
-        points[i][2] = 1;
-        theta += seg_size;
+        ox[i] = (m.a * ux[i]) + (m.b * uy[i]) + m.tx;
+        oy[i] = (m.c * ux[i]) + (m.d * uy[i]) + m.ty;
     }
-
-    return points;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-
+// A circle of NumSegments segments. Only the transform is stored, the points
+// come from UNIT_CIRCLE when drawn, see drawing::ShapeBatch.
 template <size_t NumSegments>
 struct Shape {
+    static constexpr size_t segments = NumSegments;
+
     float radius;
     float x;
     float y;
     float theta;
 
-    linalg::Matrixf<NumSegments + 2, 3> data;
     Shape(float radius, float offset_x = 0, float offset_y = 0)
         : radius(radius)
         , x(offset_x)
         , y(offset_y)
         , theta(0)
-        , data(make_circle_points<NumSegments>(radius))
     {
     }
+
+    static constexpr auto const& points() noexcept { return UNIT_CIRCLE<NumSegments>; }
 };
 
 
@@ -67,8 +145,6 @@ struct Bullet {
     linalg::Matrixf<2, 2> Xdot;
     linalg::Matrixf<2, 2> A{{{0, 1}, {0, -(1 - k)}}};
 
-    linalg::Matrixf<10 + 2, 3> data;
-
     Bullet()
         : is_active(false)
         , radius{}
@@ -80,7 +156,6 @@ struct Bullet {
         : is_active(false)
         , radius(radius)
         , theta(0)
-        , data(make_circle_points<10>(radius))
     {
     }
 
@@ -94,16 +169,20 @@ struct Bullet {
         copy_from(X[1], trajectory);
     }
 
-    auto update()
+    void update()
     {
         float dt = 1 / 30.f;
 
         Xdot = (X + (dt * A * X));
+        X    = Xdot;
+    }
 
-        auto result = data * rtransf(theta, X[0][0], X[0][1]);
-        X           = Xdot;
-
-        return result;
+    // Where to draw it, for drawing::ShapeBatch.
+    auto shape() const -> Shape<10>
+    {
+        Shape<10> shape(radius, X[0][0], X[0][1]);
+        shape.theta = theta;
+        return shape;
     }
 
     auto check_collisions()
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "animation/core.hpp"
+#include "containers/frame_arena.hpp"
+#include "containers/sparse_set.hpp"
+#include "containers/triple_buffer.hpp"
+#include "debug/counters.hpp"
+#include "debug/histogram.hpp"
+#include "drawing/atlas.hpp"
+#include "drawing/commands.hpp"
+#include "entity/core.hpp"
+#include "entity/entityallocator.hpp"
+#include "gameevents.h"
+#include "inputqueue.hpp"
+#include "linalg/matrix.hpp"
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace simulation {
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Static entities and the minkowski boundaries cached for them are stored as
+// rows of a sparse_set, so removing a wall or food mid-match keeps every
+// boundary aligned with the entity it was made from.
+//
+// Wall rows: the wall, its boundary against the player, its boundary against bullets.
+// Soft rows: the soft entity, its boundary against the player.
+using WallSet = sparse_set<entity::EntityStatic, SDL_FRect, SDL_FRect>;
+using SoftSet = sparse_set<entity::EntityStatic, SDL_FRect>;
+
+constexpr std::size_t STATIC_ENTITY   = 0;
+constexpr std::size_t PLAYER_BOUNDARY = 1;
+constexpr std::size_t BULLET_BOUNDARY = 2;
+
+void add_wall(WallSet&                    walls,
+              WallSet::id_type            id,
+              entity::EntityStatic const& wall,
+              entity::Entity const*       player);
+
+void add_soft_entity(SoftSet&                    soft_entities,
+                     SoftSet::id_type            id,
+                     entity::EntityStatic const& soft_entity,
+                     entity::Entity const*       player);
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Fixed simulation step, seconds.
+constexpr double SIM_DT = 0.05;
+
+// Movers are integrated in collision sub-steps of at most SUBSTEP_DISTANCE
+// pixels, up to MAX_SUBSTEPS per step, see collision::substep_count.
+constexpr float SUBSTEP_DISTANCE = 8.f;
+constexpr int   MAX_SUBSTEPS     = 16;
+
+// Size of each World's per tick scratch arena. Ticks use little of it so
+// far, the rest is headroom, see State::scratch_high_water.
+constexpr std::size_t SCRATCH_BYTES = 64 * 1024;
+
+// Everything the fixed step simulates. Players point into the allocator, so a
+// world never moves once made.
+struct World {
+    explicit World(SDL_Rect const& bounds);
+
+    World(World const&) = delete;
+    auto operator=(World const&) -> World& = delete;
+
+    SDL_Rect          bounds;
+    entity::Allocator alloca;
+
+    std::vector<entity::Player> players;
+
+    WallSet          walls;
+    SoftSet          soft_entities;
+    WallSet::id_type next_static_id{};
+
+    std::vector<linalg::Vectorf<2>> respawn_points;
+
+    // Scratch memory for the tick, reset at its end.
+    frame_arena scratch{SCRATCH_BYTES};
+};
+
+// Advances the world by one SIM_DT step using the current input in events.
+void step(World& world, GameEvents const& events);
+
+struct Input;
+
+// One whole tick: takes input into events, fires if the debounced fire
+// allows, steps the world and advances easer by SIM_DT.
+void tick(World& world, Input const& input, GameEvents& events, easing::Easer& easer);
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Player input for one tick. Fire is the raw key state, the simulation
+// debounces it.
+struct Input {
+    linalg::Matrixf<2, 2> player_movement{0};
+    linalg::Matrixf<2, 1> player_rotation{0};
+    bool                  fire{};
+};
+
+// Arrow keys move, diagonals at the same speed as straight lines. A and D
+// turn.
+void make_input(KeySampler const& keys, Input& input);
+
+// Walls and boundaries, copied out only when the sets change. Shared between
+// published states until then.
+struct StaticScene {
+    uint32 walls_version{};
+    uint32 soft_version{};
+
+    std::vector<SDL_FRect> walls;
+    std::vector<SDL_FRect> hard_boundaries;
+    std::vector<SDL_FRect> soft_boundaries;
+};
+
+// World state published after each tick. Bodies are full entity copies so the
+// reader can integrate them forward between ticks, the same way
+// entity::interpolate does in the world.
+struct State {
+    uint64 tick{};
+
+    // When the first input event of the latest tick that applied any was
+    // seen, see input_time(). 0 until then.
+    uint64 input_time{};
+
+    // Totals from the sim thread's TickScheduler.
+    uint64 late_ticks{};
+    uint64 dropped_ticks{};
+
+    // What recent ticks cost.
+    debug::Percentiles tick_ms;
+
+    // Ticks that allocated once warmed up, see debug::TickAllocationCheck.
+    uint64 allocating_ticks{};
+
+    // Most of World::scratch any tick has used, bytes.
+    uint64 scratch_high_water{};
+
+    std::vector<entity::Entity>         bodies; // One per player.
+    std::vector<entity::EntityRotation> aims;   // One per player.
+    std::vector<float>                  health; // One per player.
+    std::vector<entity::Entity>         bullets;
+    std::vector<SDL_FRect>              soft_entities; // Alive ones only.
+
+    std::shared_ptr<StaticScene const> statics;
+};
+
+// Copies the world into state, reusing its storage.
+void publish_state(World const& world, uint64 tick, State& state);
+
+// Integrates the bodies, aims and bullets forward by dt seconds.
+void interpolate(State& state, float dt);
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs the fixed step on its own thread, SIM_DT apart in real time, so a slow
+// render frame does not hold ticks up. Ticks that fall behind are caught up
+// within limits, see TickScheduler.
+//
+// Each tick applies the input events queued up to the time it was due, and
+// the resulting state is published to states after it. Each tick's counters
+// are pushed to telemetry, if given, and ticks that allocate once warmed up
+// are logged. The world belongs to the thread while it runs, nothing else may
+// touch it.
+class SimThread {
+public:
+    SimThread(World&                  world,
+              InputQueue&             input,
+              triple_buffer<State>&   states,
+              debug::TelemetryWriter* telemetry = nullptr);
+    ~SimThread();
+
+    SimThread(SimThread const&) = delete;
+    auto operator=(SimThread const&) -> SimThread& = delete;
+
+private:
+    void run();
+
+private:
+    World&                  world;
+    InputQueue&             input;
+    triple_buffer<State>&   states;
+    debug::TelemetryWriter* telemetry;
+    std::atomic<bool>       running{true};
+    std::thread             thread;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Plain copy of what a frame draws, taken from an interpolated state. Owns no
+// pointers into the world, so once taken it can be recorded on another thread
+// while the simulation moves on.
+struct Snapshot {
+    struct Sprite {
+        SDL_FRect            rect;
+        animation::Direction direction;
+        uint8                frame;
+    };
+
+    std::vector<Sprite>    players;
+    SDL_FRect              crosshair{};
+    std::vector<SDL_FRect> bullets;
+    std::vector<SDL_FRect> soft_entities;
+};
+
+// Fills snapshot from state, reusing its storage.
+void take_snapshot(State const& state, animation::Animator const& animator, Snapshot& snapshot);
+
+// Records the snapshot's sprites and rects. Static geometry is not included,
+// see drawing::StaticLayer and record_static.
+void record_frame(Snapshot const&       snapshot,
+                  drawing::Atlas const& atlas,
+                  drawing::CommandList& commands);
+
+// Records the walls, and the minkowski boundaries if asked to.
+void record_static(StaticScene const& statics, bool draw_minkowski, drawing::QuadBatch& batch);
+
+// Headless benchmark. Runs ticks fixed steps back to back with scripted input
+// and no window, recording each frame's draw commands without presenting, and
+// prints ticks per second. Writes per tick counters to telemetry_path if
+// given. With require_no_allocations it fails if any tick allocates once
+// warmed up, or if allocations are not being counted. Returns the process
+// exit code.
+auto run_headless(int ticks, char const* telemetry_path = nullptr, bool require_no_allocations = false) -> int;
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "typedefs.h"
+#include <chrono>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Decides how many fixed ticks to run each time the simulation wakes.
+//
+// Ticks that fell behind are caught up, but never more than MAX_CATCH_UP at
+// once, and the caller stops early once a wake has used its time budget. A
+// backlog longer than that is dropped rather than carried: simulated time
+// slows down against real time instead of every later wake running a longer
+// burst, each of which puts it further behind.
+//
+// Usage, each wake:
+//   int const due = scheduler.due(clock::now());
+//   for (int i = 0; i < due; ++i)
+//   {
+//       ... tick ...
+//       scheduler.ran(clock::now());
+//       if (scheduler.over_budget(wake, clock::now())) break;
+//   }
+//   sleep_until(scheduler.next_tick());
+class TickScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int MAX_CATCH_UP = 4;
+
+    // Totals since the scheduler started.
+    struct Report {
+        uint64 late_ticks{};    // Finished a period or more after they were due.
+        uint64 dropped_ticks{}; // Never run, their time was skipped.
+    };
+
+    TickScheduler(clock::duration period, clock::time_point start)
+        : period(period)
+        , next(start + period)
+    {
+    }
+
+    // The number of ticks due at now, at most MAX_CATCH_UP. Drops any more
+    // than that.
+    auto due(clock::time_point now) -> int
+    {
+        if (now < next)
+        {
+            return 0;
+        }
+
+        auto behind = ((now - next) / period) + 1;
+        if (behind > MAX_CATCH_UP)
+        {
+            auto const dropped = behind - MAX_CATCH_UP;
+            next += dropped * period;
+            report.dropped_ticks += static_cast<uint64>(dropped);
+            behind = MAX_CATCH_UP;
+        }
+
+        return static_cast<int>(behind);
+    }
+
+    // Call after each tick, with the time it finished.
+    void ran(clock::time_point now)
+    {
+        if ((now - next) >= period)
+        {
+            ++report.late_ticks;
+        }
+        next += period;
+    }
+
+    // A wake may spend up to one period running ticks. Past that the ticks
+    // cost more than real time allows and catching up only adds to it.
+    auto over_budget(clock::time_point wake, clock::time_point now) const -> bool
+    {
+        return (now - wake) >= period;
+    }
+
+    auto next_tick() const noexcept -> clock::time_point { return next; }
+    auto totals() const noexcept -> Report const& { return report; }
+
+private:
+    clock::duration   period;
+    clock::time_point next;
+    Report            report;
+};
+
+///////////////////////////////////////////////////////////////////////////////
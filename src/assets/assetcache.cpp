@@ -0,0 +1,566 @@
+#include "assets/assetcache.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+
+namespace assets {
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Header of a decoded image in the disk cache, followed by pitch * h bytes of
+// pixels. The source fields say which file it was decoded from, a cache file
+// whose source fields do not match the file on disk is decoded again.
+struct CacheHeader {
+    uint32 magic;
+    uint32 version;
+    int32  w;
+    int32  h;
+    int32  pitch;
+    uint32 format;
+    uint64 source_path_hash;
+    uint64 source_size;
+    int64  source_mtime;
+    uint64 content_hash;
+};
+
+constexpr uint32 CACHE_MAGIC   = 0x58504155; // "UAPX"
+constexpr uint32 CACHE_VERSION = 2;
+
+// FNV-1a. Stable between runs, unlike std::hash, so it can name cache files.
+auto hash_bytes(char const* bytes, std::size_t size) -> uint64
+{
+    uint64 hash = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8>(bytes[i]);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+auto hash_bytes(std::vector<char> const& bytes) -> uint64
+{
+    return hash_bytes(bytes.data(), bytes.size());
+}
+
+auto read_file(std::filesystem::path const& path, std::vector<char>& bytes) -> bool
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// One file per source, so a changed source overwrites its stale pixels.
+auto cache_file_name(uint64 source_path_hash, uint32 format) -> std::string
+{
+    char name[64];
+    snprintf(name,
+             sizeof(name),
+             "%016llx-%08x.pix",
+             static_cast<unsigned long long>(source_path_hash),
+             static_cast<unsigned>(format));
+    return name;
+}
+
+// Reads the pixels cached for source, which has to match on everything but
+// the image fields. Sets content_hash to the hash of the source's bytes.
+auto read_cached(std::filesystem::path const& path, CacheHeader const& source, uint64& content_hash)
+    -> std::shared_ptr<Image const>
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        return nullptr;
+    }
+
+    CacheHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    bool const valid = in &&
+                       (header.magic == source.magic) &&
+                       (header.version == source.version) &&
+                       (header.format == source.format) &&
+                       (header.source_path_hash == source.source_path_hash) &&
+                       (header.source_size == source.source_size) &&
+                       (header.source_mtime == source.source_mtime) &&
+                       (header.w > 0) && (header.h > 0) && (header.pitch > 0);
+    if (!valid)
+    {
+        return nullptr;
+    }
+
+    auto image    = std::make_shared<Image>();
+    image->w      = header.w;
+    image->h      = header.h;
+    image->pitch  = header.pitch;
+    image->format = header.format;
+    image->pixels.resize(static_cast<std::size_t>(header.pitch) * header.h);
+
+    in.read(reinterpret_cast<char*>(image->pixels.data()), image->pixels.size());
+    if (!in)
+    {
+        return nullptr;
+    }
+
+    content_hash = header.content_hash;
+    return image;
+}
+
+void write_cached(std::filesystem::path const& path, CacheHeader header, Image const& image)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Written to a temporary and renamed so a crash never leaves a truncated
+    // file behind for the next launch to trip over.
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            printf("Unable to write asset cache file %s\n", tmp_path.c_str());
+            return;
+        }
+
+        header.w     = image.w;
+        header.h     = image.h;
+        header.pitch = image.pitch;
+        out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        out.write(reinterpret_cast<char const*>(image.pixels.data()), image.pixels.size());
+    }
+
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec)
+    {
+        printf("Unable to write asset cache file %s: %s\n", path.c_str(), ec.message().c_str());
+    }
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ImageHandle::ImageHandle(AssetCache& cache, std::size_t index) noexcept
+    : cache(&cache)
+    , slot(index)
+{
+}
+
+ImageHandle::~ImageHandle()
+{
+    release();
+}
+
+ImageHandle::ImageHandle(ImageHandle const& other)
+    : cache(other.cache)
+    , slot(other.slot)
+{
+    if (cache != nullptr)
+    {
+        cache->acquire(slot);
+    }
+}
+
+auto ImageHandle::operator=(ImageHandle const& other) -> ImageHandle&
+{
+    if (this != &other)
+    {
+        if (other.cache != nullptr)
+        {
+            other.cache->acquire(other.slot);
+        }
+        release();
+        cache = other.cache;
+        slot  = other.slot;
+    }
+    return *this;
+}
+
+ImageHandle::ImageHandle(ImageHandle&& other) noexcept
+    : cache(other.cache)
+    , slot(other.slot)
+{
+    other.cache = nullptr;
+}
+
+auto ImageHandle::operator=(ImageHandle&& other) noexcept -> ImageHandle&
+{
+    if (this != &other)
+    {
+        release();
+        cache       = other.cache;
+        slot        = other.slot;
+        other.cache = nullptr;
+    }
+    return *this;
+}
+
+void ImageHandle::release() noexcept
+{
+    if (cache != nullptr)
+    {
+        cache->release(slot);
+        cache = nullptr;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+AssetCache::AssetCache(std::filesystem::path res_dir,
+                       std::filesystem::path cache_dir,
+                       uint32                pixel_format,
+                       Decoder               decoder)
+    : res_dir(std::move(res_dir))
+    , cache_dir(std::move(cache_dir))
+    , format(pixel_format)
+    , decoder(decoder)
+    , worker([this] { worker_loop(); })
+{
+}
+
+AssetCache::~AssetCache()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    queued.notify_one();
+    worker.join();
+
+    destroy_released();
+    for (auto& entry : entries)
+    {
+        if (entry.texture != nullptr)
+        {
+            SDL_DestroyTexture(entry.texture);
+        }
+    }
+}
+
+auto AssetCache::request(std::string const& file_name) -> ImageHandle
+{
+    std::error_code ec;
+    auto            path = std::filesystem::weakly_canonical(res_dir / file_name, ec);
+    if (ec)
+    {
+        path = res_dir / file_name;
+    }
+
+    std::lock_guard lock(mutex);
+
+    if (auto it = by_path.find(path.string()); it != by_path.end())
+    {
+        ++entries[it->second].ref_count;
+        return ImageHandle(*this, it->second);
+    }
+
+    std::size_t index;
+    if (free_entries.empty())
+    {
+        index = entries.size();
+        entries.emplace_back();
+    }
+    else
+    {
+        index = free_entries.back();
+        free_entries.pop_back();
+    }
+
+    auto& entry     = entries[index];
+    entry.path      = path;
+    entry.state     = State::QUEUED;
+    entry.ref_count = 1;
+
+    by_path.emplace(path.string(), index);
+    jobs.push_back(index);
+    queued.notify_one();
+
+    return ImageHandle(*this, index);
+}
+
+auto AssetCache::wait(ImageHandle const& handle) -> Image const*
+{
+    if (!handle)
+    {
+        return nullptr;
+    }
+
+    // Looked up by index after every wake, a request() on another thread may
+    // have grown entries while the lock was released.
+    std::size_t const index = handle.index();
+    std::unique_lock  lock(mutex);
+    decoded.wait(lock, [&] { return entries[index].state != State::QUEUED; });
+    return entries[index].image.get();
+}
+
+auto AssetCache::image(ImageHandle const& handle) -> Image const*
+{
+    if (!handle)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard lock(mutex);
+    return entries[handle.index()].image.get();
+}
+
+auto AssetCache::texture(ImageHandle const& handle, SDL_Renderer* renderer) -> SDL_Texture*
+{
+    destroy_released();
+
+    Image const* decoded_image = wait(handle);
+    if (decoded_image == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Only this thread creates or destroys textures, the lock just guards the
+    // entries vector.
+    std::lock_guard lock(mutex);
+    auto&           entry = entries[handle.index()];
+    if (entry.texture != nullptr)
+    {
+        return entry.texture;
+    }
+
+    entry.texture = SDL_CreateTexture(renderer,
+                                      decoded_image->format,
+                                      SDL_TEXTUREACCESS_STATIC,
+                                      decoded_image->w,
+                                      decoded_image->h);
+    if (entry.texture == nullptr)
+    {
+        printf("Unable to create texture for %s! SDL Error: %s\n",
+               entry.path.c_str(),
+               SDL_GetError());
+        return nullptr;
+    }
+
+    SDL_UpdateTexture(entry.texture, nullptr, decoded_image->pixels.data(), decoded_image->pitch);
+    SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND);
+    return entry.texture;
+}
+
+void AssetCache::destroy_released()
+{
+    std::lock_guard lock(mutex);
+    for (SDL_Texture* texture : released_textures)
+    {
+        SDL_DestroyTexture(texture);
+    }
+    released_textures.clear();
+}
+
+void AssetCache::acquire(std::size_t index)
+{
+    std::lock_guard lock(mutex);
+    ++entries[index].ref_count;
+}
+
+void AssetCache::release(std::size_t index)
+{
+    std::lock_guard lock(mutex);
+    auto&           entry = entries[index];
+
+    if (--entry.ref_count > 0)
+    {
+        return;
+    }
+
+    by_path.erase(entry.path.string());
+    entry.image.reset();
+
+    // Any thread can let go of a handle, the texture is destroyed on the
+    // render thread.
+    if (entry.texture != nullptr)
+    {
+        released_textures.push_back(entry.texture);
+        entry.texture = nullptr;
+    }
+
+    // A queued entry still belongs to the worker, which frees it when it
+    // finishes.
+    if (entry.state != State::QUEUED)
+    {
+        free_entries.push_back(index);
+    }
+}
+
+void AssetCache::worker_loop()
+{
+    std::unique_lock lock(mutex);
+
+    while (true)
+    {
+        queued.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping)
+        {
+            return;
+        }
+
+        std::size_t const index = jobs.front();
+        jobs.pop_front();
+
+        auto const path = entries[index].path;
+
+        lock.unlock();
+        auto image = decode(path);
+        lock.lock();
+
+        auto& entry = entries[index];
+        entry.state = (image != nullptr) ? State::READY : State::FAILED;
+
+        if (entry.ref_count > 0)
+        {
+            entry.image = std::move(image);
+        }
+        else
+        {
+            // Released while it was being decoded.
+            free_entries.push_back(index);
+        }
+
+        decoded.notify_all();
+    }
+}
+
+auto AssetCache::decode(std::filesystem::path const& path) -> std::shared_ptr<Image const>
+{
+    std::error_code size_error;
+    std::error_code time_error;
+    auto const      size  = std::filesystem::file_size(path, size_error);
+    auto const      mtime = std::filesystem::last_write_time(path, time_error);
+    if (size_error || time_error)
+    {
+        printf("Unable to open image %s\n", path.c_str());
+        return nullptr;
+    }
+
+    std::string const path_string = path.string();
+
+    CacheHeader source{};
+    source.magic            = CACHE_MAGIC;
+    source.version          = CACHE_VERSION;
+    source.format           = format;
+    source.source_path_hash = hash_bytes(path_string.data(), path_string.size());
+    source.source_size      = size;
+    source.source_mtime     = static_cast<int64>(mtime.time_since_epoch().count());
+
+    auto const cache_path = cache_dir / cache_file_name(source.source_path_hash, format);
+
+    // A cache hit knows the content hash without reading the file.
+    std::vector<char> bytes;
+    uint64            content_hash = 0;
+
+    auto image = read_cached(cache_path, source, content_hash);
+    if (image == nullptr)
+    {
+        if (!read_file(path, bytes))
+        {
+            printf("Unable to open image %s\n", path.c_str());
+            return nullptr;
+        }
+        content_hash = hash_bytes(bytes);
+    }
+
+    if (auto shared = find_duplicate(content_hash, path, size, bytes))
+    {
+        return shared;
+    }
+
+    if (image == nullptr)
+    {
+        image = decoder(bytes, format, path.c_str());
+        if (image == nullptr)
+        {
+            return nullptr;
+        }
+
+        source.content_hash = content_hash;
+        write_cached(cache_path, source, *image);
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        by_content[content_hash] = Content{path, size, image};
+    }
+    return image;
+}
+
+// Returns the image of another file with the same bytes, if one is loaded.
+// bytes holds the file's contents, or is empty if they have not been read.
+auto AssetCache::find_duplicate(uint64                       content_hash,
+                                std::filesystem::path const& path,
+                                uint64                       size,
+                                std::vector<char>&           bytes) -> std::shared_ptr<Image const>
+{
+    Content candidate;
+    {
+        std::lock_guard lock(mutex);
+        auto            it = by_content.find(content_hash);
+        if (it == by_content.end())
+        {
+            return nullptr;
+        }
+        candidate = it->second;
+    }
+
+    auto shared = candidate.image.lock();
+    if ((shared == nullptr) || (candidate.size != size))
+    {
+        return nullptr;
+    }
+
+    // Equal hashes are almost always equal files, but only the bytes say so.
+    if (bytes.empty() && !read_file(path, bytes))
+    {
+        return nullptr;
+    }
+
+    std::vector<char> candidate_bytes;
+    if (!read_file(candidate.path, candidate_bytes) || (candidate_bytes != bytes))
+    {
+        return nullptr;
+    }
+    return shared;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+auto find_resource_dir(std::filesystem::path const& start) -> std::optional<std::filesystem::path>
+{
+    std::error_code ec;
+    auto            dir = std::filesystem::absolute(start, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    while (true)
+    {
+        auto candidate = dir / "res";
+        if (std::filesystem::is_directory(candidate, ec))
+        {
+            return candidate;
+        }
+
+        if (!dir.has_parent_path() || (dir.parent_path() == dir))
+        {
+            return std::nullopt;
+        }
+        dir = dir.parent_path();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
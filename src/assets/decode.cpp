@@ -0,0 +1,77 @@
+#include "assets/assetcache.hpp"
+#include <SDL2/SDL_image.h>
+#include <cstring>
+#include <stdio.h>
+
+// SDL_image and the renderer queries live here, so the cache itself only
+// needs SDL for its textures.
+
+namespace assets {
+
+///////////////////////////////////////////////////////////////////////////////
+
+auto decode_image(std::vector<char> const& bytes, uint32 format, char const* name)
+    -> std::shared_ptr<Image const>
+{
+    SDL_RWops*   rw      = SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size()));
+    SDL_Surface* decoded = IMG_Load_RW(rw, 1);
+    if (decoded == nullptr)
+    {
+        printf("Unable to load image %s! SDL_image Error: %s\n", name, IMG_GetError());
+        return nullptr;
+    }
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(decoded, format, 0);
+    SDL_FreeSurface(decoded);
+    if (converted == nullptr)
+    {
+        printf("Unable to convert image %s! SDL Error: %s\n", name, SDL_GetError());
+        return nullptr;
+    }
+
+    auto image    = std::make_shared<Image>();
+    image->w      = converted->w;
+    image->h      = converted->h;
+    image->pitch  = converted->w * converted->format->BytesPerPixel;
+    image->format = format;
+    image->pixels.resize(static_cast<std::size_t>(image->pitch) * image->h);
+
+    // Drop any row padding so the cache file is just the pixels.
+    SDL_LockSurface(converted);
+    auto const* src = static_cast<uint8 const*>(converted->pixels);
+    for (int y = 0; y < image->h; ++y)
+    {
+        std::memcpy(image->pixels.data() + (static_cast<std::size_t>(y) * image->pitch),
+                    src + (static_cast<std::size_t>(y) * converted->pitch),
+                    image->pitch);
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+
+    return image;
+}
+
+auto native_pixel_format(SDL_Renderer* renderer) -> uint32
+{
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0)
+    {
+        // Sprites need alpha, take the first 32 bit format the renderer lists
+        // that has it.
+        for (uint32 i = 0; i < info.num_texture_formats; ++i)
+        {
+            uint32 const candidate = info.texture_formats[i];
+            if (!SDL_ISPIXELFORMAT_FOURCC(candidate) &&
+                SDL_ISPIXELFORMAT_ALPHA(candidate) &&
+                (SDL_BYTESPERPIXEL(candidate) == 4))
+            {
+                return candidate;
+            }
+        }
+    }
+    return SDL_PIXELFORMAT_ARGB8888;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -32,6 +32,9 @@ void detect_hard_collisions(float                                    dt,
                                                    player.s->X[0][1],
                                                    boundary);
 
+            debug::count(debug::Counter::COLLISION_CANDIDATES);
+            debug::count(debug::Counter::COLLISION_HITS, collided);
+
             if (!collided)
             {
                 player_copy = player;
@@ -8,8 +8,6 @@ void detect_soft_collisions(entity::Player&                    player,
                             std::vector<entity::EntityStatic>& game_entities,
                             std::vector<SDL_FRect>&            soft_boundaries)
 {
-    std::vector<int> interacted_with;
-
     for (int entity_idx = 0;
          (entity_idx < game_entities.size());
          ++entity_idx)
@@ -23,6 +21,9 @@ void detect_soft_collisions(entity::Player&                    player,
                                                     pX[0][1],
                                                     boundary);
 
+        debug::count(debug::Counter::COLLISION_CANDIDATES);
+        debug::count(debug::Counter::COLLISION_HITS, collided);
+
         if (collided && entity.alive)
         {
             switch (entity.kind_of)
@@ -0,0 +1,51 @@
+#include "debug/allocations.hpp"
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new and delete so every allocation is counted,
+// see debug/allocations.hpp. The array and nothrow forms call these by
+// default, the aligned forms do not so they are replaced too.
+
+namespace {
+
+auto allocate(std::size_t size) -> void*
+{
+    debug::note_allocation(size);
+
+    if (void* p = std::malloc((size != 0) ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+auto allocate_aligned(std::size_t size, std::align_val_t alignment) -> void*
+{
+    debug::note_allocation(size);
+
+    // aligned_alloc wants the size to be a multiple of the alignment.
+    auto const align   = static_cast<std::size_t>(alignment);
+    auto const rounded = ((size + align - 1) / align) * align;
+
+    if (void* p = std::aligned_alloc(align, (rounded != 0) ? rounded : align))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,28 @@
+#include "debug/draw.hpp"
+#include <stdio.h>
+
+namespace debug {
+
+auto LineBuffer::submit(SDL_Renderer* renderer) -> int
+{
+    if (indices.empty())
+    {
+        return 0;
+    }
+
+    int const result = SDL_RenderGeometry(renderer,
+                                          nullptr,
+                                          vertices.data(),
+                                          static_cast<int>(vertices.size()),
+                                          indices.data(),
+                                          static_cast<int>(indices.size()));
+    if (result != 0)
+    {
+        printf("Debug draw failed! SDL Error: %s\n", SDL_GetError());
+    }
+
+    clear();
+    return 1;
+}
+
+}
@@ -0,0 +1,121 @@
+#include "drawing/atlas.hpp"
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <stdio.h>
+
+namespace drawing {
+
+auto build_atlas(SDL_Renderer* renderer, assets::AssetCache& cache, bool keep_pixels) -> Atlas
+{
+    Atlas atlas{nullptr, ATLAS_LAYOUT.w, ATLAS_LAYOUT.h, {}};
+
+    // Queue everything up front so the worker decodes while we pack.
+    std::array<assets::ImageHandle, ATLAS_IMAGE_COUNT> handles;
+    for (std::size_t i = 0; i < ATLAS_IMAGES.size(); ++i)
+    {
+        handles[i] = cache.request(ATLAS_IMAGES[i].file_name);
+    }
+
+    // The canvas is in the renderer's format, like the decoded images, so
+    // packing and uploading are plain copies.
+    SDL_Surface* canvas = SDL_CreateRGBSurfaceWithFormat(0,
+                                                         ATLAS_LAYOUT.w,
+                                                         ATLAS_LAYOUT.h,
+                                                         32,
+                                                         cache.pixel_format());
+    if (canvas == nullptr)
+    {
+        printf("Unable to create atlas surface! SDL Error: %s\n", SDL_GetError());
+        return atlas;
+    }
+
+    bool ok = true;
+    for (std::size_t i = 0; (i < ATLAS_IMAGES.size()) && ok; ++i)
+    {
+        auto const&          expected = ATLAS_IMAGES[i];
+        assets::Image const* image    = cache.wait(handles[i]);
+        if (image == nullptr)
+        {
+            ok = false;
+            continue;
+        }
+
+        if ((image->w != expected.w) || (image->h != expected.h))
+        {
+            printf("Atlas image %s is %dx%d but ATLAS_IMAGES says %dx%d\n",
+                   expected.file_name,
+                   image->w,
+                   image->h,
+                   expected.w,
+                   expected.h);
+            ok = false;
+            continue;
+        }
+
+        SDL_Surface* loaded = SDL_CreateRGBSurfaceWithFormatFrom(
+            const_cast<uint8*>(image->pixels.data()),
+            image->w,
+            image->h,
+            32,
+            image->pitch,
+            image->format);
+        if (loaded == nullptr)
+        {
+            printf("Unable to wrap image %s! SDL Error: %s\n", expected.file_name, SDL_GetError());
+            ok = false;
+            continue;
+        }
+
+        // Copy the pixels as they are, including alpha.
+        SDL_Rect dst = ATLAS_LAYOUT.rects[i];
+        SDL_SetSurfaceBlendMode(loaded, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(loaded, nullptr, canvas, &dst);
+        SDL_FreeSurface(loaded);
+
+        printf("Packed %s\n", expected.file_name);
+    }
+
+    if (ok)
+    {
+        atlas.texture = SDL_CreateTexture(renderer,
+                                          canvas->format->format,
+                                          SDL_TEXTUREACCESS_STATIC,
+                                          canvas->w,
+                                          canvas->h);
+        if (atlas.texture == nullptr)
+        {
+            printf("Unable to create atlas texture! SDL Error: %s\n", SDL_GetError());
+        }
+        else
+        {
+            SDL_UpdateTexture(atlas.texture, nullptr, canvas->pixels, canvas->pitch);
+            SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+        }
+    }
+
+    if (ok && keep_pixels)
+    {
+        SDL_Surface* argb = SDL_ConvertSurfaceFormat(canvas, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (argb == nullptr)
+        {
+            printf("Unable to convert atlas pixels! SDL Error: %s\n", SDL_GetError());
+        }
+        else
+        {
+            atlas.pixels.resize(static_cast<std::size_t>(argb->w) * argb->h);
+            for (int y = 0; y < argb->h; ++y)
+            {
+                auto const* row = static_cast<uint8 const*>(argb->pixels) + (y * argb->pitch);
+                std::memcpy(atlas.pixels.data() + (static_cast<std::size_t>(y) * argb->w),
+                            row,
+                            argb->w * sizeof(uint32));
+            }
+            SDL_FreeSurface(argb);
+        }
+    }
+
+    SDL_FreeSurface(canvas);
+    return atlas;
+}
+
+}
@@ -0,0 +1,33 @@
+#include "drawing/batch.hpp"
+#include <stdio.h>
+
+namespace drawing {
+
+auto QuadBatch::submit(SDL_Renderer* renderer) const -> int
+{
+    int draw_calls = 0;
+
+    for (auto const& run : runs)
+    {
+        if (run.texture == nullptr)
+        {
+            SDL_SetRenderDrawBlendMode(renderer, run.blend);
+        }
+
+        int const result = SDL_RenderGeometry(renderer,
+                                              run.texture,
+                                              vertices.data() + run.first_vertex,
+                                              run.vertex_count,
+                                              indices.data() + run.first_index,
+                                              run.index_count);
+        if (result != 0)
+        {
+            printf("SDL_RenderGeometry failed! SDL Error: %s\n", SDL_GetError());
+        }
+        ++draw_calls;
+    }
+
+    return draw_calls;
+}
+
+}
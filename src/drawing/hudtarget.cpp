@@ -0,0 +1,56 @@
+#include "drawing/hudtarget.hpp"
+#include <stdio.h>
+
+namespace drawing {
+
+HudTarget::HudTarget(SDL_Renderer* renderer, SDL_Rect const& screen_rect)
+    : screen_rect(screen_rect)
+{
+    texture = SDL_CreateTexture(renderer,
+                                SDL_PIXELFORMAT_ABGR8888,
+                                SDL_TEXTUREACCESS_TARGET,
+                                screen_rect.w,
+                                screen_rect.h);
+    if (texture == nullptr)
+    {
+        printf("Unable to create %dx%d hud target! SDL Error: %s\n",
+               screen_rect.w,
+               screen_rect.h,
+               SDL_GetError());
+        return;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+HudTarget::~HudTarget()
+{
+    if (texture != nullptr)
+    {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void HudTarget::begin(SDL_Renderer* renderer) const
+{
+    SDL_SetRenderTarget(renderer, texture);
+
+    // Setting the target resets the viewport, only windows away from the
+    // origin need shifting.
+    if ((screen_rect.x != 0) || (screen_rect.y != 0))
+    {
+        SDL_Rect const viewport = hud_viewport(screen_rect);
+        SDL_RenderSetViewport(renderer, &viewport);
+    }
+}
+
+void HudTarget::end(SDL_Renderer* renderer) const
+{
+    SDL_SetRenderTarget(renderer, nullptr);
+}
+
+void HudTarget::draw(SDL_Renderer* renderer) const
+{
+    SDL_RenderCopy(renderer, texture, nullptr, &screen_rect);
+}
+
+}
@@ -0,0 +1,27 @@
+#include "drawing/shapebatch.hpp"
+#include <stdio.h>
+
+namespace drawing {
+
+auto ShapeBatch::submit(SDL_Renderer* renderer) const -> int
+{
+    if (indices.empty())
+    {
+        return 0;
+    }
+
+    int const result = SDL_RenderGeometry(renderer,
+                                          nullptr,
+                                          vertices.data(),
+                                          static_cast<int>(vertices.size()),
+                                          indices.data(),
+                                          static_cast<int>(indices.size()));
+    if (result != 0)
+    {
+        printf("SDL_RenderGeometry failed! SDL Error: %s\n", SDL_GetError());
+    }
+
+    return 1;
+}
+
+}
@@ -0,0 +1,149 @@
+#include "drawing/softraster.hpp"
+#include <stdio.h>
+
+namespace drawing {
+
+SoftRasterizer::SoftRasterizer(SDL_Renderer* renderer, int width, int height, int threads)
+{
+    texture = SDL_CreateTexture(renderer,
+                                SDL_PIXELFORMAT_ARGB8888,
+                                SDL_TEXTUREACCESS_STREAMING,
+                                width,
+                                height);
+    if (texture == nullptr)
+    {
+        printf("Unable to create %dx%d raster texture! SDL Error: %s\n",
+               width,
+               height,
+               SDL_GetError());
+        return;
+    }
+
+    frame.resize(width, height);
+
+    if (threads <= 0)
+    {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // No point in more threads than tiles.
+    threads = std::min(threads, frame.tile_count());
+
+    for (int i = 1; i < threads; ++i)
+    {
+        workers.emplace_back([this] { worker_loop(); });
+    }
+}
+
+SoftRasterizer::~SoftRasterizer()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    frame_ready.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (texture != nullptr)
+    {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void SoftRasterizer::bind_texture(SDL_Texture* key, uint32 const* texels, int w, int h)
+{
+    int const index = frame.find_texture(key);
+    if (index >= 0)
+    {
+        frame.textures[index] = RasterTexture{key, texels, w, h};
+        return;
+    }
+    frame.textures.push_back(RasterTexture{key, texels, w, h});
+}
+
+void SoftRasterizer::render(SDL_Renderer* renderer, QuadBatch const& batch, SDL_Color clear)
+{
+    if (texture == nullptr)
+    {
+        return;
+    }
+
+    bin_quads(batch, frame);
+
+    void* locked       = nullptr;
+    int   locked_pitch = 0;
+    if (SDL_LockTexture(texture, nullptr, &locked, &locked_pitch) != 0)
+    {
+        printf("Unable to lock raster texture! SDL Error: %s\n", SDL_GetError());
+        return;
+    }
+
+    // Workers left over from the last frame may still be about to take a
+    // tile, so the tile counter is reset last, after everything they read.
+    tiles_done.store(0);
+    pixels      = static_cast<uint32*>(locked);
+    pitch       = locked_pitch / static_cast<int>(sizeof(uint32));
+    clear_color = pack_argb(clear);
+    next_tile.store(0);
+
+    {
+        std::lock_guard lock(mutex);
+        ++generation;
+    }
+    frame_ready.notify_all();
+
+    run_tiles();
+
+    // Tiles can still be in flight on workers after the counter runs out.
+    {
+        std::unique_lock lock(mutex);
+        frame_done.wait(lock, [this] { return tiles_done.load() == frame.tile_count(); });
+    }
+
+    SDL_UnlockTexture(texture);
+    SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+}
+
+void SoftRasterizer::run_tiles()
+{
+    int const tile_count = frame.tile_count();
+
+    int finished = 0;
+    for (int tile = next_tile.fetch_add(1); tile < tile_count; tile = next_tile.fetch_add(1))
+    {
+        rasterize_tile(frame, tile, clear_color, pixels, pitch);
+        ++finished;
+    }
+
+    if ((finished > 0) && ((tiles_done.fetch_add(finished) + finished) == tile_count))
+    {
+        std::lock_guard lock(mutex);
+        frame_done.notify_one();
+    }
+}
+
+void SoftRasterizer::worker_loop()
+{
+    uint64 seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex);
+            frame_ready.wait(lock, [&] { return stopping || (generation != seen); });
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+        }
+
+        run_tiles();
+    }
+}
+
+}
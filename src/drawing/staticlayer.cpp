@@ -0,0 +1,51 @@
+#include "drawing/staticlayer.hpp"
+#include "screen.h"
+#include <stdio.h>
+
+namespace drawing {
+
+StaticLayer::~StaticLayer()
+{
+    if (texture != nullptr)
+    {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+auto StaticLayer::render(SDL_Renderer* renderer) -> bool
+{
+    if (texture == nullptr)
+    {
+        texture = SDL_CreateTexture(renderer,
+                                    SDL_PIXELFORMAT_ABGR8888,
+                                    SDL_TEXTUREACCESS_TARGET,
+                                    SCREEN_WIDTH,
+                                    SCREEN_HEIGHT);
+        if (texture == nullptr)
+        {
+            printf("Unable to create static layer texture! SDL Error: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
+    SDL_RenderClear(renderer);
+    batch.submit(renderer);
+
+    SDL_SetRenderTarget(renderer, previous);
+    return true;
+}
+
+void StaticLayer::draw(SDL_Renderer* renderer) const
+{
+    if (texture != nullptr)
+    {
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    }
+}
+
+}
@@ -0,0 +1,136 @@
+#include "debug/allocations.hpp"
+#include "drawing/nullrenderer.hpp"
+#include "easing/core.hpp"
+#include "screen.h"
+#include "simulation.hpp"
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+
+namespace simulation {
+
+namespace {
+
+// Deterministic input so every run exercises the same paths: the player walks
+// in a circle, turns and fires in bursts.
+void scripted_input(int tick, Input& input)
+{
+    float const angle = static_cast<float>(tick) * 0.05f;
+
+    input.player_movement = {
+        {{0.f, 0.f},
+         {std::cos(angle), std::sin(angle)}}};
+
+    input.player_rotation = {{0.f, ((tick / 40) % 2 == 0) ? 1.f : -1.f}};
+
+    input.fire = (tick % 10) < 5;
+}
+
+}
+
+auto run_headless(int ticks, char const* telemetry_path, bool require_no_allocations) -> int
+{
+    if (ticks <= 0)
+    {
+        printf("--headless needs a positive tick count.\n");
+        return -1;
+    }
+
+    if (require_no_allocations && !debug::allocations_counted())
+    {
+        printf("Headless: allocations are not counted, link src/debug/allocations.cpp.\n");
+        return -1;
+    }
+
+    easing::Easer easer;
+    GameEvents    events(easer);
+
+    World world(SDL_Rect{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT});
+
+    animation::Animator animator;
+    for (std::size_t i = 0; i < world.players.size(); ++i)
+    {
+        animator.add();
+    }
+
+    // No textures, the layout is enough to record sprites.
+    drawing::Atlas        atlas{nullptr, drawing::ATLAS_LAYOUT.w, drawing::ATLAS_LAYOUT.h, {}};
+    Input                 input;
+    State                 state;
+    Snapshot              snapshot;
+    drawing::CommandList  commands;
+    drawing::QuadBatch    batch;
+    drawing::NullRenderer renderer;
+
+    // Each row is one tick and the frame recorded after it.
+    debug::TelemetryWriter telemetry;
+    if ((telemetry_path != nullptr) && !telemetry.open(telemetry_path))
+    {
+        return -1;
+    }
+
+    // Only the tick itself is held to it, the frame side is not yet.
+    debug::TickAllocationCheck tick_allocations;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        scripted_input(tick, input);
+
+        tick_allocations.begin();
+        simulation::tick(world, input, events, easer);
+        tick_allocations.end(static_cast<uint64>(tick + 1));
+
+        // One frame per tick, so the render side is measured too. The state
+        // goes through the same copy the sim thread publishes.
+        publish_state(world, tick + 1, state);
+        for (std::size_t i = 0; i < state.bodies.size(); ++i)
+        {
+            animator.vx[i] = state.bodies[i].X[1][0];
+            animator.vy[i] = state.bodies[i].X[1][1];
+        }
+        animation::animate(animator, drawing::LRUP_TEST_FRAMES.size() / 4);
+
+        take_snapshot(state, animator, snapshot);
+
+        commands.clear();
+        record_frame(snapshot, atlas, commands);
+        commands.sort();
+
+        batch.clear();
+        commands.append_to(batch);
+        debug::count(debug::Counter::DRAW_CALLS, renderer.submit(batch));
+        renderer.present();
+
+        debug::count(debug::Counter::SIM_TICKS);
+        telemetry.write({'t', static_cast<uint64>(tick + 1), debug::counter_time(), debug::take_counters()});
+    }
+
+    auto const   end     = std::chrono::steady_clock::now();
+    double const seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("Headless: %d ticks in %.3f s, %.0f ticks/sec\n",
+           ticks,
+           seconds,
+           (seconds > 0.0) ? ticks / seconds : 0.0);
+    printf("Headless: %llu frames recorded, %.1f quads and %.1f draw calls per frame\n",
+           static_cast<unsigned long long>(renderer.frames),
+           static_cast<double>(renderer.quads) / renderer.frames,
+           static_cast<double>(renderer.draw_calls) / renderer.frames);
+    printf("Headless: %.1f KB of %.1f KB tick scratch used at most, %zu overflows\n",
+           static_cast<double>(world.scratch.high_water_mark()) / 1024.0,
+           static_cast<double>(world.scratch.capacity()) / 1024.0,
+           world.scratch.overflows());
+    printf("Headless: %llu ticks allocated after the first %llu\n",
+           static_cast<unsigned long long>(tick_allocations.allocating_ticks()),
+           static_cast<unsigned long long>(debug::TickAllocationCheck::WARM_UP));
+
+    if (require_no_allocations && (tick_allocations.allocating_ticks() != 0))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+}
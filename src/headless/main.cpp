@@ -0,0 +1,31 @@
+#include "simulation.hpp"
+#include <stdlib.h>
+#include <string>
+
+// Simulation only entry point. Built without a window, kiss_sdl or image
+// loading so it runs on machines with no display.
+//
+// Usage: UntitledHeadless [--headless] [--no-allocations] [ticks]
+//
+// --no-allocations fails the run if a tick allocates once warmed up, so it
+// can stand as a test.
+int main(int argc, char* argv[])
+{
+    int  ticks          = 10000;
+    bool no_allocations = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const arg(argv[i]);
+        if (arg == "--no-allocations")
+        {
+            no_allocations = true;
+        }
+        else if (arg != "--headless")
+        {
+            ticks = std::atoi(argv[i]);
+        }
+    }
+
+    return simulation::run_headless(ticks, nullptr, no_allocations);
+}
@@ -1,10 +1,18 @@
 #include "animation/core.hpp"
+#include "assets/assetcache.hpp"
 #include "collision/core.hpp"
 #include "containers/backfill_vector.hpp"
+#include "containers/triple_buffer.hpp"
+#include "debug/draw.hpp"
+#include "debug/histogram.hpp"
+#include "debug/hitch.hpp"
+#include "debug/profile.hpp"
+#include "debug/profilehud.hpp"
 #include "drawing/core.hpp"
 #include "easing/core.hpp"
 #include "entity/core.hpp"
 #include "entity/entityallocator.hpp"
+#include "framepacer.hpp"
 #include "gameevents.h"
 #include "gamehud.h"
 #include "linalg/matrix.hpp"
@@ -15,6 +23,7 @@
 #include "recthelper.hpp"
 #include "screen.h"
 #include "shapes.hpp"
+#include "simulation.hpp"
 #include "typedefs.h"
 // #include "spdlog/spdlog.h"
 extern "C" {
@@ -24,10 +33,12 @@ extern "C" {
 #include <SDL2/SDL.h>
 #include <algorithm>
 #include <chrono>
+#include <climits>
 #include <complex>
 #include <filesystem>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,43 +51,46 @@ extern "C" {
 
 //////////////////////////////////////////////////////////////////////////////
 
-void handle_input_states(SDL_Event& event, GameEvents& game_events, DevOptions& dev_opts)
+// Queues presses and releases of the keys the simulation reads, timestamped
+// as they are polled. Key repeats are not input.
+void queue_key_event(SDL_Event const& event, InputQueue& queue)
 {
-    int l, r, u, d;
-    int cw, cc; // clockwise, counter clockwise
-    int fire;
-
-    Uint8 const* keyboard_state = SDL_GetKeyboardState(nullptr);
-
-    fire = keyboard_state[SDL_SCANCODE_F];
-    game_events.fire.set(fire);
-
-    l = keyboard_state[SDL_SCANCODE_LEFT];
-    r = keyboard_state[SDL_SCANCODE_RIGHT];
-    u = keyboard_state[SDL_SCANCODE_UP];
-    d = keyboard_state[SDL_SCANCODE_DOWN];
-
-    cw = keyboard_state[SDL_SCANCODE_D];
-    cc = keyboard_state[SDL_SCANCODE_A];
-
+    if (((event.type != SDL_KEYDOWN) && (event.type != SDL_KEYUP)) || event.key.repeat)
     {
-        int   x_input = r - l;
-        int   y_input = u - d;
-        float x_axis  = static_cast<float>(x_input);
-        float y_axis  = static_cast<float>(y_input);
-
-        if (x_input && y_input)
-        {
-            float norm = std::sqrt((x_input * x_input) + (y_input * y_input));
-            x_axis /= norm;
-            y_axis /= norm;
-        }
+        return;
+    }
 
-        game_events.player_movement = {
-            {{0.f, 0.f},
-             {x_axis, y_axis}}};
+    Key key;
+    switch (event.key.keysym.scancode)
+    {
+    case SDL_SCANCODE_LEFT:
+        key = Key::LEFT;
+        break;
+    case SDL_SCANCODE_RIGHT:
+        key = Key::RIGHT;
+        break;
+    case SDL_SCANCODE_UP:
+        key = Key::UP;
+        break;
+    case SDL_SCANCODE_DOWN:
+        key = Key::DOWN;
+        break;
+    case SDL_SCANCODE_D:
+        key = Key::CLOCKWISE;
+        break;
+    case SDL_SCANCODE_A:
+        key = Key::COUNTER_CLOCKWISE;
+        break;
+    case SDL_SCANCODE_F:
+        key = Key::FIRE;
+        break;
+    default:
+        return;
+    }
 
-        game_events.player_rotation = {{0.f, float(cw - cc)}};
+    if (!queue.push(InputEvent{input_time(), key, event.type == SDL_KEYDOWN}))
+    {
+        printf("Input queue full, dropped a key event.\n");
     }
 }
 
@@ -102,6 +116,9 @@ void handle_input_event(SDL_Event& event, GameEvents& game_events, DevOptions& d
         case SDLK_h:
             dev_opts.display_hud = !dev_opts.display_hud;
             break;
+        case SDLK_p:
+            dev_opts.export_trace = true;
+            break;
         case SDLK_ESCAPE:
             game_events.quit = 1;
             break;
@@ -111,96 +128,6 @@ void handle_input_event(SDL_Event& event, GameEvents& game_events, DevOptions& d
     }
 }
 
-//////////////////////////////////////////////////////////////////////////////
-
-struct GameLoopTimer {
-    int32 start_frame, end_frame, time_taken, delay_time;
-    float fps;
-
-    void start()
-    {
-        start_frame = SDL_GetTicks();
-    }
-
-    void end()
-    {
-        end_frame  = SDL_GetTicks();
-        time_taken = end_frame - start_frame;
-
-        if (time_taken < 33)
-        {
-            delay_time = 33 - time_taken;
-        }
-        else
-        {
-            printf("WARNING FRAME TOOK LONGER THAN 33ms");
-            delay_time = 0;
-        }
-
-        fps = 1000.0 / float(time_taken + delay_time);
-    }
-
-    void delay()
-    {
-        SDL_Delay(delay_time);
-    }
-};
-
-///////////////////////////////////////////////////////////////////////////////
-
-SDL_Texture* load_texture(SDL_Renderer* renderer,
-                          std::string   path)
-{
-    // The final texture
-    SDL_Texture* new_texture = NULL;
-
-    // Load image at specified path
-    SDL_Surface* loaded_surface = IMG_Load(path.c_str());
-    if (loaded_surface == NULL)
-    {
-        printf("Unable to load image %s! SDL_image Error: %s\n",
-               path.c_str(),
-               IMG_GetError());
-        exit(-1);
-    }
-
-    // Create texture from surface pixels
-    new_texture = SDL_CreateTextureFromSurface(renderer, loaded_surface);
-    if (new_texture == NULL)
-    {
-        printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
-    }
-
-    printf("Loaded %s\n", path.c_str());
-
-    // Get rid of old loaded surface
-    SDL_FreeSurface(loaded_surface);
-
-    return new_texture;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-
-void make_hard_boundaries(float width, float height, std::vector<entity::EntityStatic>& game_entities, std::vector<SDL_FRect>& hard_boundaries)
-{
-    linalg::Vectorf<2> origin{{-width, -height}};
-    for (auto& hard_entity : game_entities)
-    {
-        hard_boundaries.push_back(collision::minkowski_boundary(hard_entity, origin));
-    }
-}
-
-void make_soft_boundaries(entity::Entity const*                    entity,
-                          std::vector<entity::EntityStatic> const& game_entities,
-                          std::vector<SDL_FRect>&                  soft_boundaries)
-{
-    linalg::Vectorf<2> origin{{-entity->w, -entity->h}};
-    for (auto& soft_entity : game_entities)
-    {
-        soft_boundaries.push_back(collision::minkowski_boundary(soft_entity, origin));
-    }
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 
 namespace serialisation {
@@ -210,46 +137,66 @@ extern auto load(std::filesystem::path const&, DevOptions&) -> void;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-auto make_respawn_points(SDL_Rect const&               screen,
-                         std::vector<SDL_FRect> const& hard_boundaries)
+int main(int argc, char* argv[])
 {
-    auto xseg = screen.w / 10.f;
-    auto yseg = screen.h / 10.f;
-
-    std::vector<linalg::Vectorf<2>> valid_spawn_points;
-
-    for (int i = 0; i < 10; ++i)
+    // --headless N runs N simulation ticks without a window and exits.
+    // --cpu-raster draws the world with the tiled CPU rasteriser.
+    // --vsync waits for vertical sync on present instead of pacing frames.
+    // --telemetry PATH writes per tick and per frame counters to PATH as CSV.
+    // --no-allocations fails a headless run if a tick allocates once warm.
+    bool        cpu_raster     = false;
+    bool        vsync          = false;
+    int         headless_ticks = -1;
+    char const* telemetry_path = nullptr;
+    bool        no_allocations = false;
+    for (int i = 1; i < argc; ++i)
     {
-        for (int j = 0; j < 10; ++j)
+        std::string const arg(argv[i]);
+
+        if (arg == "--headless")
         {
-            linalg::Vectorf<2> point{{xseg * j, yseg * i}};
-            for (auto const& hard_entity : hard_boundaries)
+            char*      end   = nullptr;
+            long const ticks = (i + 1 < argc) ? strtol(argv[i + 1], &end, 10) : -1;
+            bool const valid = (end != nullptr) &&
+                               (end != argv[i + 1]) &&
+                               (*end == '\0') &&
+                               (ticks >= 0) && (ticks <= INT_MAX);
+            if (!valid)
             {
-                auto collided = collision::is_point_in_rect(point, hard_entity);
-                if (!collided)
-                {
-                    valid_spawn_points.push_back(point);
-                }
+                printf("--headless needs a tick count, e.g. --headless 1000\n");
+                return 1;
+            }
+            headless_ticks = static_cast<int>(ticks);
+            ++i;
+        }
+        else if (arg == "--cpu-raster")
+        {
+            cpu_raster = true;
+        }
+        else if (arg == "--vsync")
+        {
+            vsync = true;
+        }
+        else if (arg == "--telemetry")
+        {
+            if (i + 1 >= argc)
+            {
+                printf("--telemetry needs a path, e.g. --telemetry counters.csv\n");
+                return 1;
             }
+            telemetry_path = argv[++i];
+        }
+        else if (arg == "--no-allocations")
+        {
+            no_allocations = true;
         }
     }
 
-    assert(valid_spawn_points.size() > 10);
-    return valid_spawn_points;
-}
-
-auto player_respawn(entity::Player&                        player,
-                    std::vector<linalg::Vectorf<2>> const& valid_points)
-{
-    int  index = std::rand() % valid_points.size();
-    auto point = valid_points.at(index);
-    player.respawn(point);
-}
-
-using high_res_clock = std::chrono::high_resolution_clock;
+    if (headless_ticks >= 0)
+    {
+        return simulation::run_headless(headless_ticks, telemetry_path, no_allocations);
+    }
 
-int main(int argc, char* argv[])
-{
     std::string           argv_str(argv[0]);
     std::filesystem::path exe_base_dir(argv_str.substr(0, argv_str.find_last_of("/")));
     std::filesystem::path game_state_path = (exe_base_dir / "game_state.msgpack");
@@ -259,18 +206,32 @@ int main(int argc, char* argv[])
     SDL_Event     e;
     kiss_array    objects;
 
-    entity::Allocator alloca;
-
     GameEvents game_events(easer);
     DevOptions dev_opts;
 
-    //GameLoopTimer      game_loop{0};
-    int                         draw;
-    std::vector<entity::Player> players{
-        entity::make_player(alloca, {100.f, 100.f, 80.f, 80.f}),
-        entity::make_player(alloca, {200.f, 100.f, 80.f, 80.f})};
-    auto& player_1 = players[0];
-    auto& player_2 = players[1];
+    int draw = 0;
+
+    // Create the players, game entities and minkowski boundaries. Once the
+    // sim thread starts the world is its alone, everything here reads the
+    // states it publishes instead.
+    simulation::World world(SDL_Rect{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT});
+
+    InputQueue                       sim_input;
+    triple_buffer<simulation::State> sim_states;
+
+    // The latest published state, integrated forward to the current frame.
+    simulation::State view;
+
+    // Shown in the dev hud, copied from the view each frame.
+    float player_x = 0.f;
+    float player_y = 0.f;
+    float frame_ms = 0.f;
+    float idle_pct = 0.f;
+    float input_ms = 0.f; // Key event to the present that first shows it.
+    float dropped  = 0.f; // Ticks the sim thread skipped to keep up.
+    float scratch  = 0.f; // Most KB of tick scratch memory used.
+
+    uint64 input_measured = 0;
 
     if (std::filesystem::exists(game_state_path))
     {
@@ -295,14 +256,24 @@ int main(int argc, char* argv[])
                          kiss_screen_height};
     GameHud  game_hud;
 
+    // Scope timings, beside the dev hud and below the game hud.
+    debug::ProfileHud profile_hud(SDL_Rect{screen_rect.w / 2,
+                                           game_hud.window.rect.h,
+                                           screen_rect.w / 2,
+                                           screen_rect.h - game_hud.window.rect.h});
+
 
     // TODO VariadicDataEditor: Refactor how the window, grid and data are all created.
     VariadicDataEditor window_data(
-        // std::tuple{"FPS", (const float*)&fps},
         std::tuple{"Draw Minkowski", &dev_opts.draw_minkowski},
         std::tuple{"Show Vectors", &dev_opts.draw_vectors},
-        std::tuple{"Player x", (const float*)&player_1.s->X[0][0]},
-        std::tuple{"Player y", (const float*)&player_1.s->X[0][1]});
+        std::tuple{"Player x", (const float*)&player_x},
+        std::tuple{"Player y", (const float*)&player_y},
+        std::tuple{"Frame ms", (const float*)&frame_ms},
+        std::tuple{"Idle %", (const float*)&idle_pct},
+        std::tuple{"Input ms", (const float*)&input_ms},
+        std::tuple{"Dropped ticks", (const float*)&dropped},
+        std::tuple{"Scratch KB", (const float*)&scratch});
 
     kiss_window editor_window;
     kiss_window_new(&editor_window,
@@ -325,183 +296,161 @@ int main(int argc, char* argv[])
         return -1;
     }
 
-    player_1.texture = load_texture(renderer,
-                                    "/home/dwalker0044/Projects/Untitled2D/res/lruptest.png");
+    auto res_dir = assets::find_resource_dir(exe_base_dir);
+    if (!res_dir)
+    {
+        printf("Unable to find the res directory above %s\n", exe_base_dir.c_str());
+        return -1;
+    }
+
+    assets::AssetCache asset_cache(*res_dir,
+                                   exe_base_dir / "asset_cache",
+                                   assets::native_pixel_format(renderer));
 
-    player_2.texture = load_texture(renderer,
-                                    "/home/dwalker0044/Projects/Untitled2D/res/lruptest.png");
+    // All sprites are drawn from the one atlas texture.
+    auto atlas = drawing::build_atlas(renderer, asset_cache, cpu_raster);
+    if (atlas.texture == nullptr)
+    {
+        printf("Sprite atlas could not be created!\n");
+        return -1;
+    }
+
+    for (auto& player : world.players)
+    {
+        player.texture = atlas.texture;
+    }
 
-    auto* dev_hud_texture = SDL_CreateTexture(renderer,
-                                              SDL_PIXELFORMAT_ABGR8888,
-                                              SDL_TEXTUREACCESS_TARGET,
-                                              kiss_screen_width,
-                                              kiss_screen_height);
-    SDL_SetTextureBlendMode(dev_hud_texture, SDL_BLENDMODE_BLEND);
+    // Each hud only covers its own window, the textures are sized to match.
+    drawing::HudTarget dev_hud_target(renderer, editor_window.rect);
+    drawing::HudTarget game_hud_target(renderer, game_hud.window.rect);
+    drawing::HudTarget profile_hud_target(renderer, profile_hud.window.rect);
+    if (!dev_hud_target.valid() || !game_hud_target.valid() || !profile_hud_target.valid())
+    {
+        return -1;
+    }
 
+    // Forces a full redraw of the retained hud textures, they start out with
+    // undefined contents.
+    bool hud_targets_lost = true;
 
-    auto* game_hud_texture = SDL_CreateTexture(renderer,
-                                               SDL_PIXELFORMAT_ABGR8888,
-                                               SDL_TEXTUREACCESS_TARGET,
-                                               kiss_screen_width,
-                                               kiss_screen_height);
-    SDL_SetTextureBlendMode(game_hud_texture, SDL_BLENDMODE_BLEND);
+    auto player_texture_descriptor = animation::make_LRUPDescriptor<2>(atlas.texture,
+                                                                     drawing::LRUP_TEST_FRAMES);
 
-    // Create game entities and minkowski boundaries.
-    std::vector<entity::EntityStatic> soft_entities;
-    std::vector<entity::EntityStatic> walls;
-    std::vector<SDL_FRect>            soft_boundaries;
-    std::vector<SDL_FRect>            hard_boundaries;
-    std::vector<SDL_FRect>            hard_bullet_boundaries;
+    simulation::Snapshot snapshot;
+    drawing::CommandList draw_commands;
+    drawing::QuadBatch   quad_batch;
+    drawing::StaticLayer static_layer;
 
+    // The CPU path redraws everything each frame, it has no static layer.
+    std::unique_ptr<drawing::SoftRasterizer> soft_raster;
+    if (cpu_raster)
     {
-        soft_entities.push_back(entity::make_food());
-        walls.push_back(entity::make_wall());
+        soft_raster = std::make_unique<drawing::SoftRasterizer>(renderer,
+                                                                SCREEN_WIDTH,
+                                                                SCREEN_HEIGHT);
+        if (!soft_raster->valid() || atlas.pixels.empty())
         {
-            make_hard_boundaries(player_1.s->w,
-                                 player_1.s->h,
-                                 walls,
-                                 hard_boundaries);
-            make_soft_boundaries(player_1.s,
-                                 soft_entities,
-                                 soft_boundaries);
+            return -1;
         }
+        soft_raster->bind_texture(atlas.texture, atlas.pixels.data(), atlas.w, atlas.h);
+    }
 
-        {
-            make_hard_boundaries(entity::BULLET_WIDTH, entity::BULLET_HEIGHT, walls, hard_bullet_boundaries);
-        }
+    // One animation state per player, index aligned with players.
+    animation::Animator player_animator;
+    for (std::size_t i = 0; i < world.players.size(); ++i)
+    {
+        player_animator.add();
+    }
 
-        assert(soft_entities.size() == soft_boundaries.size());
-        assert(walls.size() == hard_boundaries.size());
+    // The world is set up, from here on it belongs to the sim thread.
+    debug::TelemetryWriter telemetry;
+    if ((telemetry_path != nullptr) && !telemetry.open(telemetry_path))
+    {
+        return -1;
     }
 
-    auto respawn_points = make_respawn_points(screen_rect, hard_boundaries);
+#ifdef DISABLE_SIM
+    simulation::publish_state(world, 0, sim_states.write_buffer());
+    sim_states.publish();
+#else
+    simulation::SimThread sim_thread(world, sim_input, sim_states, &telemetry);
+#endif // DISABLE_SIM
 
-    auto player_texture_descriptor = animation::make_LRUPDescriptor<2>(player_1.texture);
-    int  accumilator               = 0;
-    int  frame                     = 0;
+    // Frames are paced to 60 Hz, or to vsync with --vsync. The simulation
+    // keeps its own tick rate on its thread either way.
+    if (vsync && (SDL_RenderSetVSync(renderer, 1) != 0))
+    {
+        printf("Could not enable vsync: %s\n", SDL_GetError());
+        vsync = false;
+    }
 
-    animation::Direction direction = animation::Direction::RIGHT;
+    FramePacer pacer(60.0, vsync);
+    double     dit         = 0;
+    uint64     frame_index = 0;
 
-    // Game loop timer stuff.
-    auto         clock = high_res_clock();
-    float        fps;
-    auto         current_time       = clock.now();
-    auto         new_time           = clock.now();
-    auto         frame_time         = std::chrono::duration<double>(new_time - current_time);
-    double       accumulator        = 0;
-    double       render_accumulator = 0;
-    double       dit                = 0;
-    const double SIM_DT             = 0.05;
-    const double SIM_DT_STEP        = SIM_DT / 4;
+    // P writes the last frames' scopes to trace.json, for chrome://tracing.
+    auto const trace_path = (exe_base_dir / "trace.json");
+    debug::profiler().name_thread("main");
 
+    // Frames over three periods are hitches, what led up to them is dumped.
+    debug::RollingHistogram<1024> frame_times;
+    debug::HitchCapture           hitches((exe_base_dir / "hitch").string(), 0.05);
 
     while (!game_events.quit)
     {
+        double const frame_time = pacer.begin_frame();
+        frame_times.add_seconds(frame_time);
+
+        // After a stall, e.g. a breakpoint or a window drag, the view only
+        // moves on by a quarter second. The sim thread drops the rest.
+        dit = std::min(frame_time, 0.25);
+
+        // Collect the last frame, and the ticks since, before looking at it.
+        debug::profiler().end_frame();
+        telemetry.flush();
+        hitches.check(frame_time, debug::profiler(), telemetry);
+        if (dev_opts.export_trace)
         {
-            new_time   = clock.now();
-            frame_time = std::chrono::duration(new_time - current_time);
-            dit        = frame_time.count();
-
-            assert(dit < 0.25);
-
-            current_time = new_time;
-            accumulator += dit;
-            render_accumulator += dit;
-
-            //std::cout << "dt: " << dit;
-        }
-
-        handle_input_states(e, game_events, dev_opts);
-
-        while (SDL_PollEvent(&e))
-        {
-            if (e.type == SDL_QUIT)
+            dev_opts.export_trace = false;
+            if (debug::profiler().write_chrome_trace(trace_path.c_str()))
             {
-                game_events.quit = 1;
+                printf("Wrote %zu frames to %s\n", debug::profiler().frame_count(), trace_path.c_str());
             }
-
-            editor_handle_events(window_data, &e, &draw);
-            game_hud.handle_events(&e, &draw, game_events);
-            handle_input_event(e, game_events, dev_opts);
         }
 
-        if (game_events.fire.get())
         {
-            player_1.fire();
-        }
+            PROFILE_SCOPE("input");
 
-#ifdef DISABLE_SIM
-#else
-        bool simulation_ran = false;
-        while (accumulator > SIM_DT)
-        {
-            //printf("s");
-            simulation_ran = true;
-            accumulator -= SIM_DT;
-
-            // Update gameplay.
-            auto player_copy = player_1;
-            bool collided    = false;
-
-            // Collision detection loop.
-            //
-            // TODO: different strategies? if collision first attempt then go smaller than dt_step?
-            // Could also try a binary search like thing.
-            // TODO: this doesn't handle colliding with several objects at once.
-
-            for (int loop_idx = 0;
-                 (loop_idx < 4) && !collided;
-                 ++loop_idx)
+            while (SDL_PollEvent(&e))
             {
-                entity::set_input(player_1.s,
-                                  game_events.player_movement);
-                entity::integrate(player_1.s,
-                                  SIM_DT_STEP);
-
-                collision::detect_hard_collisions(SIM_DT,
-                                                  SIM_DT_STEP,
-                                                  loop_idx,
-                                                  game_events,
-                                                  player_1,
-                                                  walls,
-                                                  hard_boundaries,
-                                                  collided);
-
-                // Note(DW): Doesn't need dt as player position is updated and soft collisions are static.
-                collision::detect_soft_collisions(player_1,
-                                                  soft_entities,
-                                                  soft_boundaries);
-            }
-
-            entity::set_input(player_1.aim.s,
-                              game_events.player_rotation);
-            entity::integrate(player_1.aim.s,
-                              SIM_DT);
-
-            //entity::integrate(player_1.crosshair,
-            //SIM_DT);
+#ifndef DISABLE_SIM
+                queue_key_event(e, sim_input);
+#endif // DISABLE_SIM
 
-            update_bullets(player_1,
-                           players,
-                           hard_bullet_boundaries,
-                           screen_rect,
-                           SIM_DT);
+                if (e.type == SDL_QUIT)
+                {
+                    game_events.quit = 1;
+                }
 
-            for (auto& player : players)
-            {
-                if (player.health < 0.f)
+                // Target textures lose their contents when the device resets.
+                if ((e.type == SDL_RENDER_TARGETS_RESET) || (e.type == SDL_RENDER_DEVICE_RESET))
                 {
-                    player_respawn(player, respawn_points);
+                    static_layer.invalidate();
+                    hud_targets_lost = true;
                 }
-            }
-        } // end sim loop
 
-#endif // DISABLE_SIM
+                editor_handle_events(window_data, &e, &draw);
+                game_hud.handle_events(&e, &draw, game_events);
+                handle_input_event(e, game_events, dev_opts);
+            }
+        }
 
-        if (simulation_ran)
+        // Take the latest tick if there is one. Either way the view is then
+        // integrated forward by the frame time, see below.
+        if (sim_states.update())
         {
-            // printf(".");
-            update(alloca);
+            debug::count(debug::Counter::SIM_TICKS, sim_states.read_buffer().tick - view.tick);
+            view = sim_states.read_buffer();
         }
 
         // Perform forward integration.
@@ -511,162 +460,188 @@ int main(int argc, char* argv[])
         // are much better aligned to what they should be for the render step.
         // Without this, we'd get large jumps, as there is always some time
         // remaining after the simulation.
-        interpolate(alloca, dit);
+        {
+            PROFILE_SCOPE("interpolate");
+            simulation::interpolate(view, dit);
+        }
 
-        // easing
-        easer.step(dit * 1000);
+        player_x = view.bodies[0].X[0][0];
+        player_y = view.bodies[0].X[0][1];
+        dropped  = static_cast<float>(view.dropped_ticks);
+        scratch  = static_cast<float>(view.scratch_high_water) / 1024.f;
 
-        bool render_ran = false;
-        while (render_accumulator > 0.03)
+        // easing
         {
-            //printf("r");
-            render_accumulator -= 0.03;
+            PROFILE_SCOPE("easer");
+            easer.step(dit * 1000);
+        }
 
-            // Want to check that the render only runs once per loop.
-            assert(render_ran == false);
-            render_ran = true;
+        frame_ms = pacer.report().frame_ms();
+        idle_pct = pacer.report().idle_percent();
 
+        // Render, once per frame.
+        {
 #ifdef DISABLE_RENDER
 #else
 
-            SDL_Rect player_texture_src_rect;
             // Animations
             {
-                auto const& pX = player_1.s->X;
-
-                linalg::Vectorf<2> vel{{pX[1][0], pX[1][1]}};
-                player_texture_src_rect = animation::animate(player_texture_descriptor,
-                                                             vel,
-                                                             direction,
-                                                             accumilator,
-                                                             frame);
+                PROFILE_SCOPE("animate");
+
+                for (std::size_t i = 0; i < view.bodies.size(); ++i)
+                {
+                    auto const& pX = view.bodies[i].X;
+
+                    player_animator.vx[i] = pX[1][0];
+                    player_animator.vy[i] = pX[1][1];
+                }
+
+                animation::animate(player_animator,
+                                   player_texture_descriptor.frames);
             }
 
-            // Render player.
+            // Copy out what the frame draws, record it as sort keyed commands
+            // and sort those into as few draw calls as possible. Sprites all
+            // come from the atlas so the draw call count does not grow with
+            // the number of entities. Static geometry is drawn last, as one
+            // texture copy.
             {
-                SDL_SetRenderTarget(renderer, nullptr);
-                SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0xff);
-                SDL_RenderClear(renderer);
+                PROFILE_SCOPE("draw world");
 
-                SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xff);
-
-                for (auto const& player : players)
                 {
-                    SDL_FRect dst = to_screen_rect(sdl_rect(player.r));
+                    PROFILE_SCOPE("record");
+
+                    simulation::take_snapshot(view, player_animator, snapshot);
+
+                    draw_commands.clear();
+                    simulation::record_frame(snapshot, atlas, draw_commands);
+                    draw_commands.sort();
 
-                    SDL_RenderCopyF(renderer,
-                                    player.texture,
-                                    &player_texture_src_rect,
-                                    &dst);
+                    quad_batch.clear();
+                    draw_commands.append_to(quad_batch);
                 }
 
-                // Render crosshair.
-                {
-                    entity::update_crosshair(player_1);
+                auto const& statics       = *view.statics;
+                auto        record_static = [&](drawing::QuadBatch& batch) {
+                    simulation::record_static(statics, dev_opts.draw_minkowski, batch);
+                };
 
-                    SDL_SetRenderDrawColor(renderer, 0xff, 0x00, 0x00, 0xff);
+                SDL_SetRenderTarget(renderer, nullptr);
 
-                    SDL_FRect fdst = to_screen_rect(player_1.crosshair.rect);
-                    SDL_RenderFillRectF(renderer, &fdst);
+                if (soft_raster)
+                {
+                    record_static(quad_batch);
+                    soft_raster->render(renderer, quad_batch, drawing::WHITE);
+                    debug::count(debug::Counter::DRAW_CALLS);
                 }
-
-                // Render bullets.
+                else
                 {
-                    SDL_SetRenderDrawColor(renderer, 0xff, 0x00, 0x00, 0xff);
-
-                    for (auto& bullet : player_1.bullets)
-                    {
-                        SDL_FRect fdst = to_screen_rect(sdl_rect(bullet.r));
-                        SDL_RenderFillRectF(renderer, &fdst);
-                    }
+                    // Walls and minkowski outlines only change when the static
+                    // sets do, they are redrawn into the layer texture then.
+                    static_layer.update(renderer,
+                                        {statics.walls_version,
+                                         statics.soft_version,
+                                         static_cast<uint32>(dev_opts.draw_minkowski)},
+                                        record_static);
+
+                    SDL_SetRenderTarget(renderer, nullptr);
+                    SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0xff);
+                    SDL_RenderClear(renderer);
+
+                    int const calls = quad_batch.submit(renderer);
+                    static_layer.draw(renderer);
+                    debug::count(debug::Counter::DRAW_CALLS, calls + 1);
                 }
             }
 
-            // Render game entities.
+            // Render vectors. Every arrow goes into the debug line buffer,
+            // which is drawn with one call.
             {
-                SDL_SetRenderDrawColor(renderer, 0x00, 0xff, 0x00, 0xff);
-                for (auto& entity : soft_entities)
-                {
-                    if (entity.alive)
-                    {
-                        SDL_FRect fdst = to_screen_rect(entity.rect);
-                        SDL_RenderFillRectF(renderer, &fdst);
-                    }
-                }
+                PROFILE_SCOPE("debug draw");
 
-                SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xff);
-                for (auto& entity : walls)
-                {
-                    SDL_FRect fdst = to_screen_rect(entity.rect);
-                    SDL_RenderFillRectF(renderer, &fdst);
-                }
+                debug::set_enabled(dev_opts.draw_vectors);
+
+                auto draw_velocity = [](entity::Entity const& body) {
+                    debug::arrow(body.X[0][0], body.X[0][1], body.Y[1][0], body.Y[1][1]);
+                };
 
-                if (dev_opts.draw_minkowski)
+                for (auto const& body : view.bodies)
                 {
-                    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0xff, 0xff);
-
-                    for (auto& boundary : hard_boundaries)
-                    {
-                        auto dst = to_screen_rect(boundary);
-                        SDL_RenderDrawRectF(renderer, &dst);
-                    }
-
-                    for (auto& boundary : soft_boundaries)
-                    {
-                        auto dst = to_screen_rect(boundary);
-                        SDL_RenderDrawRectF(renderer, &dst);
-                    }
+                    draw_velocity(body);
                 }
 
-                SDL_SetRenderDrawColor(renderer, 0xff, 0x00, 0x00, 0xff);
-                if (dev_opts.draw_vectors)
+                for (auto const& bullet : view.bullets)
                 {
-                    auto const& pX = player_1.r->X;
-                    auto const& pY = player_1.r->Y;
-                    drawing::draw_vector(renderer,
-                                         pX[0][0],
-                                         pX[0][1],
-                                         pY[1][0],
-                                         pY[1][1]);
+                    draw_velocity(bullet);
                 }
+
+                debug::count(debug::Counter::DRAW_CALLS, debug::submit(renderer));
             }
 
 #endif // DISABLE_RENDER
 
-            // Render game hud.
+            // Render game hud. The hud textures are retained, only widgets
+            // that changed are redrawn into them.
             {
-                game_hud.update(player_2);
-                game_hud.render(renderer, game_hud_texture);
+                PROFILE_SCOPE("game hud");
+
+                game_hud.update(view.health[1]);
+                game_hud.render(renderer, game_hud_target, hud_targets_lost);
             }
 
-            // Render dev hud. This is a bit wasteful if the hud is not enabled
-            // however for not it is good to do so we can keep an eye on CPU usage.
+            // Render dev hud. Changes are still tracked while it is hidden so
+            // it is up to date when shown.
             {
+                PROFILE_SCOPE("dev hud");
+
                 window_update(window_data);
-                window_render(renderer, dev_hud_texture, &editor_window, window_data);
+                profile_hud.update(debug::profiler(), frame_times.percentiles(), view.tick_ms);
+
+                if (dev_opts.display_hud || hud_targets_lost)
+                {
+                    window_render(renderer,
+                                  dev_hud_target,
+                                  &editor_window,
+                                  window_data,
+                                  hud_targets_lost);
+                    profile_hud.render(renderer, profile_hud_target, hud_targets_lost);
+                }
+                hud_targets_lost = false;
             }
 
             // Copy textures from kiss to the screen.
             {
-                SDL_RenderCopy(renderer,
-                               game_hud_texture,
-                               &game_hud.window.rect,
-                               &game_hud.window.rect);
+                PROFILE_SCOPE("present");
+
+                game_hud_target.draw(renderer);
+                debug::count(debug::Counter::DRAW_CALLS);
 
                 if (dev_opts.display_hud)
                 {
-                    SDL_RenderCopy(renderer,
-                                   dev_hud_texture,
-                                   &editor_window.rect,
-                                   &editor_window.rect);
+                    dev_hud_target.draw(renderer);
+                    profile_hud_target.draw(renderer);
+                    debug::count(debug::Counter::DRAW_CALLS, 2);
                 }
 
-
+                pacer.begin_present();
                 SDL_RenderPresent(renderer);
+
+                // The first present of a state with new input shows it.
+                if (view.input_time != input_measured)
+                {
+                    input_measured = view.input_time;
+                    input_ms       = static_cast<float>((input_time() - input_measured) / 1e6);
+                }
             }
+
+            // Textures of images released since the last frame, from any thread.
+            asset_cache.destroy_released();
         }
 
-        SDL_Delay(1);
+        telemetry.write({'f', ++frame_index, debug::counter_time(), debug::take_counters()});
+
+        // Sleeps until the next frame is due.
+        pacer.end_frame();
     } // end while
 
     serialisation::save(game_state_path, dev_opts);
@@ -0,0 +1,479 @@
+#include "simulation.hpp"
+#include "collision/core.hpp"
+#include "debug/allocations.hpp"
+#include "debug/histogram.hpp"
+#include "debug/profile.hpp"
+#include "tickscheduler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <stdlib.h>
+
+namespace simulation {
+
+///////////////////////////////////////////////////////////////////////////////
+
+void add_wall(WallSet&                    walls,
+              WallSet::id_type            id,
+              entity::EntityStatic const& wall,
+              entity::Entity const*       player)
+{
+    linalg::Vectorf<2> player_origin{{-player->w, -player->h}};
+    linalg::Vectorf<2> bullet_origin{{-entity::BULLET_WIDTH, -entity::BULLET_HEIGHT}};
+
+    walls.insert(id,
+                 wall,
+                 collision::minkowski_boundary(wall, player_origin),
+                 collision::minkowski_boundary(wall, bullet_origin));
+}
+
+void add_soft_entity(SoftSet&                    soft_entities,
+                     SoftSet::id_type            id,
+                     entity::EntityStatic const& soft_entity,
+                     entity::Entity const*       player)
+{
+    linalg::Vectorf<2> origin{{-player->w, -player->h}};
+
+    soft_entities.insert(id,
+                         soft_entity,
+                         collision::minkowski_boundary(soft_entity, origin));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+auto make_respawn_points(SDL_Rect const&               screen,
+                         std::vector<SDL_FRect> const& hard_boundaries)
+{
+    auto xseg = screen.w / 10.f;
+    auto yseg = screen.h / 10.f;
+
+    std::vector<linalg::Vectorf<2>> valid_spawn_points;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        for (int j = 0; j < 10; ++j)
+        {
+            linalg::Vectorf<2> point{{xseg * j, yseg * i}};
+            for (auto const& hard_entity : hard_boundaries)
+            {
+                auto collided = collision::is_point_in_rect(point, hard_entity);
+                if (!collided)
+                {
+                    valid_spawn_points.push_back(point);
+                }
+            }
+        }
+    }
+
+    assert(valid_spawn_points.size() > 10);
+    return valid_spawn_points;
+}
+
+auto player_respawn(entity::Player&                        player,
+                    std::vector<linalg::Vectorf<2>> const& valid_points)
+{
+    int  index = std::rand() % valid_points.size();
+    auto point = valid_points.at(index);
+    player.respawn(point);
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+World::World(SDL_Rect const& bounds)
+    : bounds(bounds)
+    , alloca{entity::make_entity_alloca()}
+{
+    players.push_back(entity::make_player(alloca, {100.f, 100.f, 80.f, 80.f}));
+    players.push_back(entity::make_player(alloca, {200.f, 100.f, 80.f, 80.f}));
+
+    auto const* player = players[0].s;
+
+    add_soft_entity(soft_entities, next_static_id++, entity::make_food(), player);
+    add_wall(walls, next_static_id++, entity::make_wall(), player);
+
+    respawn_points = make_respawn_points(bounds, walls.column<PLAYER_BOUNDARY>());
+}
+
+void step(World& world, GameEvents const& events)
+{
+    auto& player_1 = world.players[0];
+
+    bool collided = false;
+
+    // Collision detection loop.
+    //
+    // TODO: different strategies? if collision first attempt then go smaller than dt_step?
+    // Could also try a binary search like thing.
+    // TODO: this doesn't handle colliding with several objects at once.
+
+    int const   player_steps = collision::substep_count(entity::speed(player_1.s), SIM_DT, SUBSTEP_DISTANCE, MAX_SUBSTEPS);
+    float const player_dt    = SIM_DT / player_steps;
+
+    for (int loop_idx = 0;
+         (loop_idx < player_steps) && !collided;
+         ++loop_idx)
+    {
+        PROFILE_SCOPE("player substep");
+
+        entity::set_input(player_1.s,
+                          events.player_movement);
+        entity::integrate(player_1.s,
+                          player_dt);
+
+        collision::detect_hard_collisions(SIM_DT,
+                                          player_dt,
+                                          loop_idx,
+                                          events,
+                                          player_1,
+                                          world.walls.column<STATIC_ENTITY>(),
+                                          world.walls.column<PLAYER_BOUNDARY>(),
+                                          collided);
+
+        // Note(DW): Doesn't need dt as player position is updated and soft collisions are static.
+        collision::detect_soft_collisions(player_1,
+                                          world.soft_entities.column<STATIC_ENTITY>(),
+                                          world.soft_entities.column<PLAYER_BOUNDARY>());
+    }
+
+    entity::set_input(player_1.aim.s,
+                      events.player_rotation);
+    entity::integrate(player_1.aim.s,
+                      SIM_DT);
+
+    // Bullets all step together, as finely as the fastest one needs.
+    float bullet_speed = 0.f;
+    for (auto const& bullet : player_1.bullets)
+    {
+        bullet_speed = std::max(bullet_speed, entity::speed(bullet.s));
+    }
+
+    {
+        PROFILE_SCOPE("update bullets");
+        update_bullets(player_1,
+                       world.players,
+                       world.walls.column<BULLET_BOUNDARY>(),
+                       world.bounds,
+                       SIM_DT,
+                       collision::substep_count(bullet_speed, SIM_DT, SUBSTEP_DISTANCE, MAX_SUBSTEPS),
+                       &world.scratch);
+    }
+
+    for (auto& player : world.players)
+    {
+        if (player.health < 0.f)
+        {
+            player_respawn(player, world.respawn_points);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void make_input(KeySampler const& keys, Input& input)
+{
+    int const x_input = int(keys.down(Key::RIGHT)) - int(keys.down(Key::LEFT));
+    int const y_input = int(keys.down(Key::UP)) - int(keys.down(Key::DOWN));
+    float     x_axis  = static_cast<float>(x_input);
+    float     y_axis  = static_cast<float>(y_input);
+
+    if (x_input && y_input)
+    {
+        float norm = std::sqrt((x_input * x_input) + (y_input * y_input));
+        x_axis /= norm;
+        y_axis /= norm;
+    }
+
+    input.player_movement = {
+        {{0.f, 0.f},
+         {x_axis, y_axis}}};
+
+    int const turn        = int(keys.down(Key::CLOCKWISE)) - int(keys.down(Key::COUNTER_CLOCKWISE));
+    input.player_rotation = {{0.f, float(turn)}};
+
+    input.fire = keys.down(Key::FIRE);
+}
+
+void tick(World& world, Input const& input, GameEvents& events, easing::Easer& easer)
+{
+    PROFILE_SCOPE("tick");
+
+    events.player_movement = input.player_movement;
+    events.player_rotation = input.player_rotation;
+    events.fire.set(input.fire);
+
+    if (events.fire.get())
+    {
+        world.players[0].fire();
+    }
+
+    step(world, events);
+    entity::update(world.alloca);
+
+    // Nothing made from scratch outlives the tick.
+    debug::count(debug::Counter::SCRATCH_BYTES, world.scratch.used());
+    world.scratch.reset();
+
+    for (auto const& player : world.players)
+    {
+        debug::count(debug::Counter::LIVE_BULLETS, player.bullets.size());
+    }
+
+    PROFILE_SCOPE("sim easer");
+    easer.step(static_cast<int>(SIM_DT * 1000));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void publish_state(World const& world, uint64 tick, State& state)
+{
+    state.tick = tick;
+
+    state.bodies.clear();
+    state.aims.clear();
+    state.health.clear();
+    state.bullets.clear();
+    for (auto const& player : world.players)
+    {
+        state.bodies.push_back(*player.s);
+        state.aims.push_back(*player.aim.s);
+        state.health.push_back(player.health);
+
+        for (auto const& bullet : player.bullets)
+        {
+            state.bullets.push_back(*bullet.s);
+        }
+    }
+
+    state.soft_entities.clear();
+    for (auto const& entity : world.soft_entities.column<STATIC_ENTITY>())
+    {
+        if (entity.alive)
+        {
+            state.soft_entities.push_back(entity.rect);
+        }
+    }
+
+    // Walls rarely change, the copy is only redone when they do. Readers
+    // holding the old scene keep it alive until they let go.
+    uint32 const walls_version = world.walls.version();
+    uint32 const soft_version  = world.soft_entities.version();
+
+    if (!state.statics
+        || (state.statics->walls_version != walls_version)
+        || (state.statics->soft_version != soft_version))
+    {
+        auto statics = std::make_shared<StaticScene>();
+
+        statics->walls_version = walls_version;
+        statics->soft_version  = soft_version;
+        for (auto const& wall : world.walls.column<STATIC_ENTITY>())
+        {
+            statics->walls.push_back(wall.rect);
+        }
+        statics->hard_boundaries = world.walls.column<PLAYER_BOUNDARY>();
+        statics->soft_boundaries = world.soft_entities.column<PLAYER_BOUNDARY>();
+
+        state.statics = std::move(statics);
+    }
+}
+
+void interpolate(State& state, float dt)
+{
+    for (auto& body : state.bodies)
+    {
+        entity::integrate(&body, dt);
+    }
+
+    for (auto& aim : state.aims)
+    {
+        entity::integrate(&aim, dt);
+    }
+
+    for (auto& bullet : state.bullets)
+    {
+        entity::integrate(&bullet, dt);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SimThread::SimThread(World&                  world,
+                     InputQueue&             input,
+                     triple_buffer<State>&   states,
+                     debug::TelemetryWriter* telemetry)
+    : world(world)
+    , input(input)
+    , states(states)
+    , telemetry(telemetry)
+{
+    // The reader has a state to show before the first tick.
+    publish_state(world, 0, states.write_buffer());
+    states.publish();
+
+    thread = std::thread([this] { run(); });
+}
+
+SimThread::~SimThread()
+{
+    running.store(false);
+    thread.join();
+}
+
+void SimThread::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    auto const dt = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(SIM_DT));
+
+    // The debounce timers run on simulation time, so they live here.
+    easing::Easer easer;
+    GameEvents    events(easer);
+    uint64        ticks      = 0;
+    uint64        input_seen = 0;
+    KeySampler    keys;
+    Input         tick_input;
+    TickScheduler scheduler(dt, clock::now());
+
+    // What ticks cost, over the last minute or so.
+    debug::RollingHistogram<1024> tick_times;
+    debug::TickAllocationCheck    tick_allocations;
+
+    debug::profiler().name_thread("sim");
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_until(scheduler.next_tick());
+
+        auto const wake = clock::now();
+        int const  due  = scheduler.due(wake);
+
+        for (int i = 0; i < due; ++i)
+        {
+            // Only input from before the tick was due, so each tick of a
+            // catch-up burst gets its own.
+            if (uint64 const first = keys.sample(input, input_time(scheduler.next_tick())))
+            {
+                input_seen = first;
+            }
+            make_input(keys, tick_input);
+
+            auto const started = clock::now();
+            tick_allocations.begin();
+            tick(world, tick_input, events, easer);
+            tick_allocations.end(ticks + 1);
+
+            auto const done = clock::now();
+            scheduler.ran(done);
+            tick_times.add_seconds(std::chrono::duration<double>(done - started).count());
+
+            // Taken every tick so they stay per tick. The writer keeps the
+            // recent ones for hitch captures and streams them if asked.
+            debug::CounterRow const row{'t', ticks + 1, debug::counter_time(), debug::take_counters()};
+            if (telemetry != nullptr)
+            {
+                telemetry->push(row);
+            }
+
+            PROFILE_SCOPE("publish");
+
+            State& state = states.write_buffer();
+            publish_state(world, ++ticks, state);
+            state.input_time         = input_seen;
+            state.late_ticks         = scheduler.totals().late_ticks;
+            state.dropped_ticks      = scheduler.totals().dropped_ticks;
+            state.tick_ms            = tick_times.percentiles();
+            state.allocating_ticks   = tick_allocations.allocating_ticks();
+            state.scratch_high_water = world.scratch.high_water_mark();
+            states.publish();
+
+            if (scheduler.over_budget(wake, done))
+            {
+                break;
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void take_snapshot(State const& state, animation::Animator const& animator, Snapshot& snapshot)
+{
+    snapshot.players.clear();
+    for (std::size_t i = 0; i < state.bodies.size(); ++i)
+    {
+        snapshot.players.push_back({sdl_rect(state.bodies[i]),
+                                    animator.directions[i],
+                                    animator.frames[i]});
+    }
+
+    snapshot.crosshair = entity::make_crosshair().rect;
+    entity::place_crosshair(snapshot.crosshair, state.bodies[0], state.aims[0]);
+
+    snapshot.bullets.clear();
+    for (auto const& bullet : state.bullets)
+    {
+        snapshot.bullets.push_back(sdl_rect(bullet));
+    }
+
+    snapshot.soft_entities = state.soft_entities;
+}
+
+void record_frame(Snapshot const&       snapshot,
+                  drawing::Atlas const& atlas,
+                  drawing::CommandList& commands)
+{
+    using drawing::Layer;
+
+    auto const descriptor = animation::make_LRUPDescriptor<2>(atlas.texture,
+                                                              drawing::LRUP_TEST_FRAMES);
+
+    for (auto const& player : snapshot.players)
+    {
+        SDL_Rect src = animation::get_frame_rect(descriptor,
+                                                 player.direction,
+                                                 player.frame);
+        commands.sprite(Layer::ENTITIES, atlas, src, player.rect);
+    }
+
+    for (auto const& bullet : snapshot.bullets)
+    {
+        commands.fill_rect(Layer::PROJECTILES, bullet, drawing::RED);
+    }
+
+    for (auto const& soft_entity : snapshot.soft_entities)
+    {
+        commands.fill_rect(Layer::PICKUPS, soft_entity, drawing::GREEN);
+    }
+
+    commands.fill_rect(Layer::OVERLAY, snapshot.crosshair, drawing::RED);
+}
+
+void record_static(StaticScene const& statics, bool draw_minkowski, drawing::QuadBatch& batch)
+{
+    for (auto const& wall : statics.walls)
+    {
+        batch.fill_rect(wall, drawing::GREY);
+    }
+
+    if (draw_minkowski)
+    {
+        for (auto const& boundary : statics.hard_boundaries)
+        {
+            batch.outline_rect(boundary, drawing::BLUE);
+        }
+
+        for (auto const& boundary : statics.soft_boundaries)
+        {
+            batch.outline_rect(boundary, drawing::BLUE);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,114 @@
+#include "easing/timerwheel.hpp"
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+// Compares the timer wheel against the linear countdown scan the Easer used
+// to do, for per-entity sized timer counts. Each frame steps 16 ms and
+// re-arms every timer that fires, so the number of live timers stays fixed.
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct LinearTimer {
+    int  time_ms;
+    bool running;
+};
+
+auto random_delays(std::size_t count) -> std::vector<int>
+{
+    std::mt19937                       rng(1234);
+    std::uniform_int_distribution<int> dist(50, 5000);
+
+    std::vector<int> delays(count);
+    for (auto& delay : delays)
+    {
+        delay = dist(rng);
+    }
+    return delays;
+}
+
+auto bench_linear(std::vector<int> const& delays, int frames) -> double
+{
+    std::vector<LinearTimer> timers;
+    for (auto delay : delays)
+    {
+        timers.push_back({delay, true});
+    }
+
+    std::size_t fired = 0;
+    auto        start = bench_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        for (std::size_t i = 0; i < timers.size(); ++i)
+        {
+            auto& timer = timers[i];
+            if (timer.running)
+            {
+                timer.time_ms -= 16;
+                if (timer.time_ms <= 0)
+                {
+                    fired += 1;
+                    timer.time_ms = delays[i];
+                }
+            }
+        }
+    }
+
+    auto end = bench_clock::now();
+    printf("  linear scan: %zu fired, ", fired);
+    return std::chrono::duration<double, std::micro>(end - start).count() / frames;
+}
+
+auto bench_wheel(std::vector<int> const& delays, int frames) -> double
+{
+    easing::TimerWheel wheel;
+    wheel.reserve(delays.size());
+
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        wheel.schedule(delays[i], static_cast<uint32>(i));
+    }
+
+    std::size_t fired = 0;
+    auto        start = bench_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        wheel.advance(16, [&](uint32 index) {
+            fired += 1;
+            wheel.schedule(delays[index], index);
+        });
+    }
+
+    auto end = bench_clock::now();
+    printf("  timer wheel: %zu fired, ", fired);
+    return std::chrono::duration<double, std::micro>(end - start).count() / frames;
+}
+
+}
+
+#ifdef BENCH_TIMER_WHEEL
+int main()
+{
+    int const frames = 2000;
+
+    for (std::size_t count : {100, 1000, 10000, 50000})
+    {
+        auto delays = random_delays(count);
+
+        printf("%zu timers, %d frames of 16 ms\n", count, frames);
+
+        auto linear_us = bench_linear(delays, frames);
+        printf("%.2f us/frame\n", linear_us);
+
+        auto wheel_us = bench_wheel(delays, frames);
+        printf("%.2f us/frame\n", wheel_us);
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,123 @@
+#include "algorithms/find.hpp"
+#include "containers/backfill_vector.hpp"
+#include "debug/allocations.hpp"
+#include "debug/profile.hpp"
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+// Needs src/debug/allocations.cpp linked in, see the test target.
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_allocations_are_counted()
+{
+    assert(debug::allocations_counted());
+
+    auto const start = debug::thread_allocations();
+    auto       value = std::make_unique<uint64>(7);
+
+    auto const allocated = debug::allocations_since(start);
+    assert(allocated.count == 1);
+    assert(allocated.bytes == sizeof(uint64));
+    assert(*value == 7);
+}
+
+void test_allocations_per_thread()
+{
+    auto const start = debug::thread_allocations();
+
+    std::thread worker([] {
+        std::vector<int> v(100);
+        assert(debug::thread_allocations().count >= 1);
+    });
+    worker.join();
+
+    // The thread object itself may allocate here, the vector did not.
+    assert(debug::allocations_since(start).bytes < 100 * sizeof(int));
+}
+
+void test_tick_check_allows_warm_up()
+{
+    debug::TickAllocationCheck check(2);
+
+    for (uint64 tick = 1; tick <= 4; ++tick)
+    {
+        check.begin();
+        std::vector<int> v(tick);
+        bool const clean = check.end(tick);
+        assert(clean == (tick <= 2));
+    }
+    assert(check.allocating_ticks() == 2);
+
+    check.begin();
+    assert(check.end(5));
+    assert(check.allocating_ticks() == 2);
+}
+
+// The bullet update's find and remove, once its scratch has been reserved.
+void test_find_and_remove_do_not_allocate()
+{
+    backfill_vector<int, 10> values;
+    for (int i = 0; i < 10; ++i)
+    {
+        values.increase() = i;
+    }
+
+    std::vector<std::size_t> indices;
+    indices.reserve(values.max_size());
+
+    auto const start = debug::thread_allocations();
+
+    auto odd = [](int x) { return (x % 2) == 1; };
+    algorithm::find_indices(values, odd, indices);
+    values.remove(indices);
+
+    assert(debug::allocations_since(start).count == 0);
+    assert(values.size() == 5);
+    for (int value : values)
+    {
+        assert((value % 2) == 0);
+    }
+}
+
+void test_scopes_record_allocations()
+{
+    debug::Profiler profiler;
+
+    {
+        debug::ProfileScope scope("allocates", profiler);
+        std::vector<int>    v(10);
+    }
+    {
+        debug::ProfileScope scope("does not", profiler);
+    }
+    profiler.end_frame();
+
+    std::vector<debug::ScopeAverage> averages;
+    profiler.averages(averages);
+    assert(averages.size() == 2);
+
+    for (auto const& average : averages)
+    {
+        bool const allocates = (std::strcmp(average.name, "allocates") == 0);
+        assert(average.allocations == (allocates ? 1.0 : 0.0));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_ALLOCATIONS
+int main()
+{
+    test_allocations_are_counted();
+    test_allocations_per_thread();
+    test_tick_check_allows_warm_up();
+    test_find_and_remove_do_not_allocate();
+    test_scopes_record_allocations();
+    printf("Test allocations complete.\n");
+}
+#endif
@@ -0,0 +1,144 @@
+#include "animation/animator.hpp"
+#include <cassert>
+#include <cmath>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+// The trig based direction selection that select_direction replaces.
+auto reference_direction(float vx, float vy) -> animation::Direction
+{
+    float const segs[4]{
+        45.f * M_PI / 180.f,
+        45.f * 3 * M_PI / 180.f,
+        45.f * 5 * M_PI / 180.f,
+        45.f * 7 * M_PI / 180.f};
+
+    auto theta = std::atan2(-vy, vx);
+    if (theta < 0)
+    {
+        theta += 2 * M_PI;
+    }
+
+    if (theta >= segs[0] && theta < segs[1])
+    {
+        return animation::Direction::DOWN;
+    }
+    if (theta >= segs[1] && theta < segs[2])
+    {
+        return animation::Direction::LEFT;
+    }
+    if (theta >= segs[2] && theta < segs[3])
+    {
+        return animation::Direction::UP;
+    }
+    return animation::Direction::RIGHT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_select_direction_axes()
+{
+    using animation::Direction;
+    using animation::select_direction;
+
+    assert(select_direction(100.f, 0.f) == Direction::RIGHT);
+    assert(select_direction(-100.f, 0.f) == Direction::LEFT);
+    assert(select_direction(0.f, 100.f) == Direction::UP);
+    assert(select_direction(0.f, -100.f) == Direction::DOWN);
+}
+
+void test_select_direction_matches_trig()
+{
+    // Integer velocities include the exact diagonals.
+    for (int vx = -60; vx <= 60; ++vx)
+    {
+        for (int vy = -60; vy <= 60; ++vy)
+        {
+            if (vx == 0 && vy == 0)
+            {
+                continue;
+            }
+            assert(animation::select_direction(vx, vy) == reference_direction(vx, vy));
+        }
+    }
+}
+
+void test_animator_keeps_state_per_entity()
+{
+    animation::Animator animator;
+    auto                fast = animator.add();
+    auto                idle = animator.add(animation::Direction::UP);
+
+    animator.vx[fast] = -100.f;
+    animator.vy[fast] = 0.f;
+    animator.vx[idle] = 5.f;
+    animator.vy[idle] = 0.f;
+
+    for (int i = 0; i < 30; ++i)
+    {
+        animation::animate(animator, 2);
+    }
+
+    assert(animator.directions[fast] == animation::Direction::LEFT);
+    assert(animator.frames[fast] == 1);
+
+    // Idle entities keep facing the way they were going.
+    assert(animator.directions[idle] == animation::Direction::UP);
+    assert(animator.frames[idle] == 0);
+
+    for (int i = 0; i < 30; ++i)
+    {
+        animation::animate(animator, 2);
+    }
+    assert(animator.frames[fast] == 0);
+}
+
+void test_medium_speed_winds_back()
+{
+    animation::Animator animator;
+    auto                index = animator.add();
+
+    animator.vx[index] = 100.f;
+    for (int i = 0; i < 20; ++i)
+    {
+        animation::animate(animator, 2);
+    }
+
+    animator.vx[index] = 30.f;
+    for (int i = 0; i < 40; ++i)
+    {
+        animation::animate(animator, 2);
+    }
+    assert(animator.accumulators[index] == 0);
+    assert(animator.frames[index] == 0);
+}
+
+void test_fast_advances_every_30_updates()
+{
+    animation::Animator animator;
+    auto                index = animator.add();
+    animator.vx[index]        = 100.f;
+
+    // Long enough for a carried remainder to have made a frame come early.
+    for (int update = 1; update <= 30 * 400; ++update)
+    {
+        uint8 const before = animator.frames[index];
+        animation::animate(animator, 2);
+        assert((animator.frames[index] != before) == ((update % 30) == 0));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_ANIMATION
+int main()
+{
+    test_select_direction_axes();
+    test_select_direction_matches_trig();
+    test_animator_keeps_state_per_entity();
+    test_medium_speed_winds_back();
+    test_fast_advances_every_30_updates();
+    printf("Test animation complete.\n");
+}
+#endif
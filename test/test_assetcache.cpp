@@ -0,0 +1,235 @@
+#include "assets/assetcache.hpp"
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Needs src/assets/assetcache.cpp linked in, see the test target. Decoding
+// and the SDL texture calls are stubbed out below, the test executables do not
+// link SDL or SDL_image.
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+std::atomic<int> decodes{0};
+int              textures_created   = 0;
+int              textures_destroyed = 0;
+char             fake_textures[16];
+
+auto* const FAKE_RENDERER = reinterpret_cast<SDL_Renderer*>(0x10);
+
+// One byte per pixel, the file's bytes in a row.
+auto fake_decode(std::vector<char> const& bytes, uint32 format, char const*)
+    -> std::shared_ptr<assets::Image const>
+{
+    ++decodes;
+
+    auto image    = std::make_shared<assets::Image>();
+    image->w      = static_cast<int>(bytes.size());
+    image->h      = 1;
+    image->pitch  = image->w;
+    image->format = format;
+    image->pixels.assign(bytes.begin(), bytes.end());
+    return image;
+}
+
+void write_text(std::filesystem::path const& path, std::string const& text)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+// A fresh res and cache directory for each test.
+auto fresh_dir(char const* name) -> std::filesystem::path
+{
+    auto dir = std::filesystem::temp_directory_path() / "untitled2d_test_assetcache" / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "res");
+    return dir;
+}
+
+}
+
+SDL_Texture* SDL_CreateTexture(SDL_Renderer*, Uint32, int, int, int)
+{
+    assert(textures_created < 16);
+    return reinterpret_cast<SDL_Texture*>(&fake_textures[textures_created++]);
+}
+
+int SDL_UpdateTexture(SDL_Texture*, SDL_Rect const*, void const*, int) { return 0; }
+int SDL_SetTextureBlendMode(SDL_Texture*, SDL_BlendMode) { return 0; }
+void SDL_DestroyTexture(SDL_Texture*) { ++textures_destroyed; }
+char const* SDL_GetError() { return ""; }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_same_path_shares_an_entry()
+{
+    auto const dir = fresh_dir("path");
+    write_text(dir / "res" / "a.png", "aaaa");
+
+    decodes = 0;
+    assets::AssetCache cache(dir / "res", dir / "cache", 1, fake_decode);
+
+    auto first  = cache.request("a.png");
+    auto second = cache.request("sub/../a.png");
+    assert(first.index() == second.index());
+
+    assets::Image const* image = cache.wait(first);
+    assert(image != nullptr);
+    assert(image->w == 4);
+    assert(decodes == 1);
+}
+
+void test_same_content_shares_an_image()
+{
+    auto const dir = fresh_dir("content");
+    write_text(dir / "res" / "a.png", "same bytes");
+    write_text(dir / "res" / "b.png", "same bytes");
+    write_text(dir / "res" / "c.png", "else bytes");
+
+    decodes = 0;
+    assets::AssetCache cache(dir / "res", dir / "cache", 1, fake_decode);
+
+    auto a = cache.request("a.png");
+    auto b = cache.request("b.png");
+    auto c = cache.request("c.png");
+    assert(a.index() != b.index());
+
+    // The worker takes requests in order, so b finds a already decoded.
+    assert(cache.wait(a) == cache.wait(b));
+    assert(cache.wait(c) != cache.wait(a));
+    assert(decodes == 2);
+}
+
+void test_released_textures_wait_for_the_render_thread()
+{
+    auto const dir = fresh_dir("release");
+    write_text(dir / "res" / "a.png", "aaaa");
+    write_text(dir / "res" / "b.png", "bbbb");
+
+    textures_created   = 0;
+    textures_destroyed = 0;
+    {
+        assets::AssetCache cache(dir / "res", dir / "cache", 1, fake_decode);
+
+        auto first  = cache.request("a.png");
+        auto second = first;
+
+        SDL_Texture* texture = cache.texture(first, FAKE_RENDERER);
+        assert(texture != nullptr);
+        std::size_t const index = first.index();
+
+        // One copy left, the image and texture stay.
+        first = assets::ImageHandle{};
+        assert(cache.image(second) != nullptr);
+        assert(cache.texture(second, FAKE_RENDERER) == texture);
+        assert(textures_created == 1);
+
+        // The last copy let go of on another thread.
+        std::thread([handle = std::move(second)] {}).join();
+        assert(textures_destroyed == 0);
+
+        cache.destroy_released();
+        assert(textures_destroyed == 1);
+
+        // The entry is free for the next request.
+        auto other = cache.request("b.png");
+        assert(other.index() == index);
+        assert(cache.wait(other) != nullptr);
+    }
+    assert(textures_destroyed == 1);
+}
+
+// Requests on another thread grow the entries while wait() sleeps.
+void test_wait_while_requests_grow_the_cache()
+{
+    auto const dir = fresh_dir("grow");
+    for (int i = 0; i < 64; ++i)
+    {
+        write_text(dir / "res" / (std::to_string(i) + ".png"), std::to_string(i * 1000));
+    }
+
+    assets::AssetCache cache(dir / "res", dir / "cache", 1, fake_decode);
+    auto               first = cache.request("0.png");
+
+    std::vector<assets::ImageHandle> handles;
+    std::thread                      requester([&] {
+        for (int i = 1; i < 64; ++i)
+        {
+            handles.push_back(cache.request(std::to_string(i) + ".png"));
+        }
+    });
+
+    assert(cache.wait(first) != nullptr);
+    requester.join();
+
+    for (auto const& handle : handles)
+    {
+        assert(cache.wait(handle) != nullptr);
+    }
+}
+
+void test_disk_cache_round_trip()
+{
+    auto const dir = fresh_dir("disk");
+    write_text(dir / "res" / "a.png", "pixels");
+
+    auto load = [&](char const* expected) {
+        assets::AssetCache cache(dir / "res", dir / "cache", 1, fake_decode);
+        auto               handle = cache.request("a.png");
+
+        assets::Image const* image = cache.wait(handle);
+        assert(image != nullptr);
+        assert(std::string(image->pixels.begin(), image->pixels.end()) == expected);
+    };
+
+    // Decoded once, then read back.
+    decodes = 0;
+    load("pixels");
+    assert(decodes == 1);
+    load("pixels");
+    assert(decodes == 1);
+
+    // A header that does not match is decoded again.
+    std::filesystem::path cache_file;
+    for (auto const& file : std::filesystem::directory_iterator(dir / "cache"))
+    {
+        cache_file = file.path();
+    }
+    {
+        std::fstream file(cache_file, std::ios::binary | std::ios::in | std::ios::out);
+        uint32 const version = 0;
+        file.seekp(sizeof(uint32));
+        file.write(reinterpret_cast<char const*>(&version), sizeof(version));
+    }
+    load("pixels");
+    assert(decodes == 2);
+    load("pixels");
+    assert(decodes == 2);
+
+    // So is a changed file.
+    write_text(dir / "res" / "a.png", "changed pixels");
+    load("changed pixels");
+    assert(decodes == 3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_ASSETCACHE
+int main()
+{
+    test_same_path_shares_an_entry();
+    test_same_content_shares_an_image();
+    test_released_textures_wait_for_the_render_thread();
+    test_wait_while_requests_grow_the_cache();
+    test_disk_cache_round_trip();
+    printf("Test asset cache complete.\n");
+}
+#endif
@@ -0,0 +1,113 @@
+#include "drawing/atlas.hpp"
+#include <cassert>
+#include <stdio.h>
+
+namespace {
+
+constexpr auto overlaps(SDL_Rect const& a, SDL_Rect const& b) -> bool
+{
+    return (a.x < b.x + b.w) && (b.x < a.x + a.w) && (a.y < b.y + b.h) && (b.y < a.y + a.h);
+}
+
+constexpr auto contains(SDL_Rect const& outer, SDL_Rect const& inner) -> bool
+{
+    return (inner.x >= outer.x) && (inner.y >= outer.y)
+           && (inner.x + inner.w <= outer.x + outer.w)
+           && (inner.y + inner.h <= outer.y + outer.h);
+}
+
+template <std::size_t N>
+constexpr auto no_overlaps(std::array<SDL_Rect, N> const& rects) -> bool
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = i + 1; j < N; ++j)
+        {
+            if (overlaps(rects[i], rects[j]))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <std::size_t N>
+constexpr auto all_inside(std::array<SDL_Rect, N> const& rects, SDL_Rect const& outer) -> bool
+{
+    for (auto const& rect : rects)
+    {
+        if (!contains(outer, rect))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// The game's atlas: every image placed, none overlapping, all inside.
+static_assert(no_overlaps(drawing::ATLAS_LAYOUT.rects));
+static_assert(all_inside(drawing::ATLAS_LAYOUT.rects, SDL_Rect{0, 0, drawing::ATLAS_LAYOUT.w, drawing::ATLAS_LAYOUT.h}));
+static_assert(drawing::ATLAS_LAYOUT.rects[drawing::ATLAS_LRUP_TEST].w == drawing::ATLAS_IMAGES[drawing::ATLAS_LRUP_TEST].w);
+static_assert(drawing::ATLAS_LAYOUT.rects[drawing::ATLAS_PLAYER].h == drawing::ATLAS_IMAGES[drawing::ATLAS_PLAYER].h);
+
+// The walk cycle: 2 by 4 frames of 80 x 80 tiling the sheet, row major.
+static_assert(drawing::LRUP_TEST_FRAMES.size() == 8);
+static_assert(no_overlaps(drawing::LRUP_TEST_FRAMES));
+static_assert(all_inside(drawing::LRUP_TEST_FRAMES, drawing::ATLAS_LAYOUT.rects[drawing::ATLAS_LRUP_TEST]));
+static_assert(drawing::LRUP_TEST_FRAMES[0].x == drawing::ATLAS_LAYOUT.rects[drawing::ATLAS_LRUP_TEST].x);
+static_assert(drawing::LRUP_TEST_FRAMES[0].y == drawing::ATLAS_LAYOUT.rects[drawing::ATLAS_LRUP_TEST].y);
+static_assert(drawing::LRUP_TEST_FRAMES[1].x == drawing::LRUP_TEST_FRAMES[0].x + 80);
+static_assert(drawing::LRUP_TEST_FRAMES[2].y == drawing::LRUP_TEST_FRAMES[0].y + 80);
+static_assert(drawing::LRUP_TEST_FRAMES[7].w == 80 && drawing::LRUP_TEST_FRAMES[7].h == 80);
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_full_shelf_starts_a_new_one()
+{
+    constexpr std::array<drawing::AtlasImage, 4> images{{
+        {"a", 60, 40},
+        {"b", 40, 30},
+        {"c", 50, 20}, // Does not fit beside a and b.
+        {"d", 50, 10},
+    }};
+    constexpr auto layout = drawing::pack_atlas(images, 100);
+
+    static_assert(no_overlaps(layout.rects));
+    static_assert(all_inside(layout.rects, SDL_Rect{0, 0, 100, layout.h}));
+
+    assert(layout.rects[1].x == 60 && layout.rects[1].y == 0);
+
+    // The second shelf sits under the tallest image of the first.
+    assert(layout.rects[2].x == 0 && layout.rects[2].y == 40);
+    assert(layout.rects[3].x == 50 && layout.rects[3].y == 40);
+    assert(layout.w == 100);
+    assert(layout.h == 60);
+}
+
+void test_grid_frames_split_evenly()
+{
+    constexpr auto frames = drawing::make_grid_frames<3, 2>(SDL_Rect{10, 20, 90, 40});
+
+    static_assert(no_overlaps(frames));
+    static_assert(all_inside(frames, SDL_Rect{10, 20, 90, 40}));
+
+    assert(frames[0].x == 10 && frames[0].y == 20);
+    assert(frames[2].x == 70 && frames[2].w == 30);
+    assert(frames[3].x == 10 && frames[3].y == 40 && frames[3].h == 20);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_ATLAS
+int main()
+{
+    test_full_shelf_starts_a_new_one();
+    test_grid_frames_split_evenly();
+    printf("Test atlas complete.\n");
+}
+#endif
@@ -0,0 +1,123 @@
+#include "drawing/batch.hpp"
+#include <cassert>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_fill_rect_is_flipped()
+{
+    drawing::QuadBatch batch;
+    batch.fill_rect({10.f, 20.f, 30.f, 40.f}, {0xff, 0x00, 0x00, 0xff});
+
+    auto const& v = batch.vertex_list();
+    assert(v.size() == 4);
+
+    // Same rect as to_screen_rect gives.
+    assert(v[0].position.x == 10.f);
+    assert(v[0].position.y == to_screen_y(20.f) - 40.f);
+    assert(v[2].position.x == 40.f);
+    assert(v[2].position.y == to_screen_y(20.f));
+    assert(v[0].color.r == 0xff && v[0].color.g == 0x00);
+}
+
+void test_colours_share_a_run()
+{
+    drawing::QuadBatch batch;
+    for (int i = 0; i < 100; ++i)
+    {
+        SDL_Color colour{static_cast<Uint8>(i), 0x00, 0x00, 0xff};
+        batch.fill_rect({float(i), 0.f, 1.f, 1.f}, colour);
+    }
+
+    assert(batch.quad_count() == 100);
+    assert(batch.run_list().size() == 1);
+    assert(batch.run_list()[0].index_count == 600);
+}
+
+void test_texture_changes_start_runs()
+{
+    auto*     atlas = reinterpret_cast<SDL_Texture*>(0x10);
+    auto*     other = reinterpret_cast<SDL_Texture*>(0x20);
+    SDL_Rect  src   = {0, 0, 10, 10};
+    SDL_FRect dst   = {0.f, 0.f, 10.f, 10.f};
+
+    drawing::QuadBatch batch;
+    batch.sprite(atlas, 100, 100, src, dst);
+    batch.sprite(atlas, 100, 100, src, dst);
+    batch.fill_rect(dst, drawing::WHITE);
+    batch.sprite(other, 100, 100, src, dst);
+
+    auto const& runs = batch.run_list();
+    assert(runs.size() == 3);
+    assert(runs[0].texture == atlas && runs[0].vertex_count == 8);
+    assert(runs[1].texture == nullptr && runs[1].first_vertex == 8);
+    assert(runs[2].texture == other && runs[2].first_index == 18);
+
+    // Indices are relative to their run.
+    auto const& indices = batch.index_list();
+    assert(indices[runs[0].first_index + 6] == 4);
+    assert(indices[runs[2].first_index] == 0);
+}
+
+void test_blend_changes_start_runs()
+{
+    auto*     atlas = reinterpret_cast<SDL_Texture*>(0x10);
+    SDL_FRect dst   = {0.f, 0.f, 10.f, 10.f};
+
+    drawing::QuadBatch batch;
+    batch.fill_rect(dst, drawing::WHITE);
+    batch.set_blend_mode(SDL_BLENDMODE_BLEND);
+    batch.fill_rect(dst, drawing::WHITE);
+
+    // Sprites keep their texture's mode, so they are not split.
+    batch.sprite(atlas, 100, 100, {0, 0, 10, 10}, dst);
+    batch.set_blend_mode(SDL_BLENDMODE_NONE);
+    batch.sprite(atlas, 100, 100, {0, 0, 10, 10}, dst);
+
+    auto const& runs = batch.run_list();
+    assert(runs.size() == 3);
+    assert(runs[0].blend == SDL_BLENDMODE_NONE);
+    assert(runs[1].blend == SDL_BLENDMODE_BLEND);
+    assert(runs[2].texture == atlas && runs[2].vertex_count == 8);
+}
+
+void test_sprite_uvs()
+{
+    drawing::QuadBatch batch;
+    batch.sprite(nullptr, 200, 100, {50, 25, 100, 50}, {0.f, 0.f, 1.f, 1.f});
+
+    auto const& v = batch.vertex_list();
+    assert(v[0].tex_coord.x == 0.25f && v[0].tex_coord.y == 0.25f);
+    assert(v[2].tex_coord.x == 0.75f && v[2].tex_coord.y == 0.75f);
+}
+
+void test_clear_keeps_capacity()
+{
+    drawing::QuadBatch batch;
+    for (int i = 0; i < 10; ++i)
+    {
+        batch.fill_rect({0.f, 0.f, 1.f, 1.f}, drawing::WHITE);
+    }
+
+    auto const* data = batch.vertex_list().data();
+    batch.clear();
+    assert(batch.quad_count() == 0 && batch.run_list().empty());
+
+    batch.fill_rect({0.f, 0.f, 1.f, 1.f}, drawing::WHITE);
+    assert(batch.vertex_list().data() == data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_BATCH
+int main()
+{
+    test_fill_rect_is_flipped();
+    test_colours_share_a_run();
+    test_texture_changes_start_runs();
+    test_blend_changes_start_runs();
+    test_sprite_uvs();
+    test_clear_keeps_capacity();
+    printf("Test batch complete.\n");
+}
+#endif
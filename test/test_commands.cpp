@@ -0,0 +1,138 @@
+#include "drawing/commands.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_sort_key_fields()
+{
+    using namespace drawing;
+
+    uint64 const key = make_sort_key(Layer::OVERLAY, 0x1234, Blend::BLEND, 0xdeadbeef);
+    assert(key_layer(key) == Layer::OVERLAY);
+    assert(key_texture_id(key) == 0x1234);
+    assert(key_blend(key) == Blend::BLEND);
+    assert(key_depth(key) == 0xdeadbeef);
+
+    // Layer outranks everything below it.
+    assert(make_sort_key(Layer::ENTITIES, 0, Blend::NONE, 0)
+           > make_sort_key(Layer::GROUND, 0xffff, Blend::BLEND, 0xffffffff));
+}
+
+void test_layers_then_textures()
+{
+    auto*          texture = reinterpret_cast<SDL_Texture*>(0x10);
+    drawing::Atlas atlas{texture, 100, 100, {}};
+
+    drawing::CommandList commands;
+    commands.fill_rect(drawing::Layer::OVERLAY, {0.f, 0.f, 1.f, 1.f}, drawing::RED);
+    commands.sprite(drawing::Layer::ENTITIES, atlas, {0, 0, 10, 10}, {0.f, 0.f, 10.f, 10.f});
+    commands.fill_rect(drawing::Layer::ENTITIES, {0.f, 0.f, 1.f, 1.f}, drawing::RED);
+    commands.sprite(drawing::Layer::ENTITIES, atlas, {0, 0, 10, 10}, {0.f, 0.f, 10.f, 10.f});
+    commands.fill_rect(drawing::Layer::GROUND, {0.f, 0.f, 1.f, 1.f}, drawing::GREEN);
+    commands.sort();
+
+    auto const& order = commands.draw_order();
+    assert(order.size() == 5);
+    assert(order[0] == 4);
+    assert(order[1] == 2);
+    assert(order[2] == 1 && order[3] == 3);
+    assert(order[4] == 0);
+
+    // Interleaved sprites and rects become one run each.
+    drawing::QuadBatch batch;
+    commands.append_to(batch);
+    assert(batch.quad_count() == 5);
+    assert(batch.run_list().size() == 3);
+    assert(batch.run_list()[1].texture == texture);
+    assert(batch.run_list()[1].vertex_count == 8);
+}
+
+// The game's frame: players, then bullets, then food, as they were drawn
+// before commands were sorted.
+void test_bullets_draw_over_players()
+{
+    auto*          texture = reinterpret_cast<SDL_Texture*>(0x10);
+    drawing::Atlas atlas{texture, 100, 100, {}};
+
+    drawing::CommandList commands;
+    commands.fill_rect(drawing::Layer::PICKUPS, {0.f, 0.f, 1.f, 1.f}, drawing::GREEN);
+    commands.fill_rect(drawing::Layer::PROJECTILES, {0.f, 0.f, 1.f, 1.f}, drawing::RED);
+    commands.sprite(drawing::Layer::ENTITIES, atlas, {0, 0, 10, 10}, {0.f, 0.f, 10.f, 10.f});
+    commands.sort();
+
+    auto const& order = commands.draw_order();
+    assert(order.size() == 3);
+    assert(order[0] == 2);
+    assert(order[1] == 1);
+    assert(order[2] == 0);
+}
+
+void test_blend_modes_split_runs()
+{
+    drawing::CommandList commands;
+    commands.fill_rect(drawing::Layer::GROUND, {0.f, 0.f, 1.f, 1.f}, drawing::RED, drawing::Blend::BLEND);
+    commands.fill_rect(drawing::Layer::GROUND, {0.f, 0.f, 1.f, 1.f}, drawing::RED);
+    commands.fill_rect(drawing::Layer::GROUND, {0.f, 0.f, 1.f, 1.f}, drawing::RED, drawing::Blend::BLEND);
+    commands.sort();
+
+    drawing::QuadBatch batch;
+    commands.append_to(batch);
+
+    auto const& runs = batch.run_list();
+    assert(runs.size() == 2);
+    assert(runs[0].blend == SDL_BLENDMODE_NONE && runs[0].vertex_count == 4);
+    assert(runs[1].blend == SDL_BLENDMODE_BLEND && runs[1].vertex_count == 8);
+}
+
+void test_sort_matches_stable_sort()
+{
+    drawing::CommandList commands;
+
+    srand(1);
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto const layer = static_cast<drawing::Layer>(rand() % 5);
+        auto const blend = static_cast<drawing::Blend>(rand() % 2);
+        auto const depth = static_cast<uint32>(rand() % 4) << (8 * (rand() % 4));
+        commands.fill_rect(layer, {float(i), 0.f, 1.f, 1.f}, drawing::WHITE, blend, depth);
+    }
+    commands.sort();
+
+    auto const& list  = commands.command_list();
+    auto const& order = commands.draw_order();
+    for (std::size_t i = 1; i < order.size(); ++i)
+    {
+        uint64 const a = list[order[i - 1]].key;
+        uint64 const b = list[order[i]].key;
+        assert((a < b) || ((a == b) && (order[i - 1] < order[i])));
+    }
+}
+
+void test_clear_resets()
+{
+    drawing::CommandList commands;
+    commands.fill_rect(drawing::Layer::GROUND, {0.f, 0.f, 1.f, 1.f}, drawing::RED);
+    commands.sort();
+    commands.clear();
+    commands.sort();
+
+    assert(commands.size() == 0);
+    assert(commands.draw_order().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_COMMANDS
+int main()
+{
+    test_sort_key_fields();
+    test_layers_then_textures();
+    test_bullets_draw_over_players();
+    test_blend_modes_split_runs();
+    test_sort_matches_stable_sort();
+    test_clear_resets();
+    printf("Test commands complete.\n");
+}
+#endif
@@ -0,0 +1,121 @@
+#include "debug/counters.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <string>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_take_starts_again_from_zero()
+{
+    debug::take_counters();
+
+    debug::count(debug::Counter::POINT_IN_RECT);
+    debug::count(debug::Counter::POINT_IN_RECT);
+    debug::count(debug::Counter::UPDATE_BYTES, 100);
+
+    auto const taken = debug::take_counters();
+    assert(taken[debug::Counter::POINT_IN_RECT] == 2);
+    assert(taken[debug::Counter::UPDATE_BYTES] == 100);
+    assert(taken[debug::Counter::DRAW_CALLS] == 0);
+
+    assert(debug::take_counters()[debug::Counter::POINT_IN_RECT] == 0);
+}
+
+void test_threads_count_separately()
+{
+    debug::take_counters();
+    debug::count(debug::Counter::DRAW_CALLS, 3);
+
+    debug::Counters other;
+    std::thread     worker([&] {
+        debug::count(debug::Counter::DRAW_CALLS, 5);
+        other = debug::take_counters();
+    });
+    worker.join();
+
+    assert(other[debug::Counter::DRAW_CALLS] == 5);
+    assert(debug::take_counters()[debug::Counter::DRAW_CALLS] == 3);
+}
+
+auto read_file(char const* path) -> std::string
+{
+    std::string text;
+
+    FILE* file = fopen(path, "r");
+    assert(file != nullptr);
+
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), file) != nullptr)
+    {
+        text += buffer;
+    }
+    fclose(file);
+    return text;
+}
+
+void test_csv_rows()
+{
+    char const* path = "test_counters.csv";
+
+    {
+        debug::TelemetryWriter telemetry;
+        assert(telemetry.open(path));
+
+        debug::Counters counters;
+        counters[debug::Counter::COLLISION_CANDIDATES] = 7;
+        counters[debug::Counter::COLLISION_HITS]       = 2;
+
+        // A tick from another thread, written by the next flush.
+        std::thread sim([&] { telemetry.push({'t', 1, 2'000'000, counters}); });
+        sim.join();
+
+        telemetry.flush();
+        telemetry.write({'f', 1, 3'000'000, {}});
+    }
+
+    std::string const text = read_file(path);
+    remove(path);
+
+    assert(text.rfind("kind,index,time_ms,point_in_rect,collision_candidates,collision_hits,", 0) == 0);
+    assert(text.find("\nt,1,") != std::string::npos);
+    assert(text.find(",0,7,2,0,0,0,0,0,0,0\n") != std::string::npos);
+    assert(text.find("\nf,1,") != std::string::npos);
+    assert(text.find(",0,0,0,0,0,0,0,0,0,0\n") != std::string::npos);
+}
+
+void test_closed_writer_keeps_recent_rows()
+{
+    debug::TelemetryWriter telemetry;
+    assert(!telemetry.is_open());
+
+    for (uint64 i = 1; i <= debug::TelemetryWriter::RECENT + 10; ++i)
+    {
+        telemetry.push({'t', i, 0, {}});
+        telemetry.flush();
+    }
+
+    char const* path = "test_counters_recent.csv";
+    assert(telemetry.write_recent(path));
+
+    std::string const text = read_file(path);
+    remove(path);
+
+    // Only the last RECENT rows, oldest first.
+    assert(text.find("\nt,10,") == std::string::npos);
+    assert(text.find("\nt,11,") != std::string::npos);
+    assert(text.find("\nt,11,") < text.find("\nt,1034,"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_COUNTERS
+int main()
+{
+    test_take_starts_again_from_zero();
+    test_threads_count_separately();
+    test_csv_rows();
+    test_closed_writer_keeps_recent_rows();
+    printf("Test counters complete.\n");
+}
+#endif
@@ -0,0 +1,98 @@
+#include "debug/draw.hpp"
+#include <cassert>
+#include <cmath>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+auto near(float a, float b) -> bool
+{
+    return std::fabs(a - b) < 1e-4f;
+}
+
+}
+
+void test_line_is_one_pixel_quad()
+{
+    debug::LineBuffer buffer;
+    buffer.line(10.f, 20.f, 30.f, 20.f);
+
+    auto const& v = buffer.vertex_list();
+    assert(buffer.line_count() == 1);
+    assert(buffer.index_list().size() == 6);
+
+    // Horizontal, so offset half a pixel up and down, flipped into screen y.
+    assert(near(v[0].position.x, 10.f) && near(v[0].position.y, to_screen_y(20.5f)));
+    assert(near(v[2].position.x, 30.f) && near(v[2].position.y, to_screen_y(19.5f)));
+}
+
+void test_zero_length_draws_nothing()
+{
+    debug::LineBuffer buffer;
+    buffer.line(5.f, 5.f, 5.f, 5.f);
+    buffer.arrow(5.f, 5.f, 0.f, 0.f);
+    assert(buffer.line_count() == 0);
+}
+
+void test_shapes_line_counts()
+{
+    debug::LineBuffer buffer;
+
+    buffer.rect({0.f, 0.f, 10.f, 10.f});
+    assert(buffer.line_count() == 4);
+
+    buffer.arrow(0.f, 0.f, 50.f, 0.f);
+    assert(buffer.line_count() == 8);
+
+    buffer.circle(0.f, 0.f, 10.f, debug::RED, 16);
+    assert(buffer.line_count() == 24);
+
+    // Indices keep pointing at their own quad.
+    auto const& indices = buffer.index_list();
+    assert(indices[(23 * 6) + 5] == (23 * 4) + 3);
+}
+
+void test_arrow_head_points_back()
+{
+    debug::LineBuffer buffer;
+    buffer.arrow(0.f, 0.f, 0.f, 100.f);
+
+    // Second line runs from the tip to a head point 10 back and 10 across.
+    auto const& v = buffer.vertex_list();
+    float const x = (v[4 + 1].position.x + v[4 + 2].position.x) / 2.f;
+    float const y = (v[4 + 1].position.y + v[4 + 2].position.y) / 2.f;
+    assert(near(std::fabs(x), 10.f));
+    assert(near(y, to_screen_y(90.f)));
+}
+
+void test_disabled_draws_are_skipped()
+{
+    debug::frame().clear();
+
+    debug::set_enabled(false);
+    debug::line(0.f, 0.f, 10.f, 10.f);
+    debug::rect({0.f, 0.f, 10.f, 10.f});
+    assert(debug::frame().line_count() == 0);
+
+    debug::set_enabled(true);
+    debug::line(0.f, 0.f, 10.f, 10.f);
+    assert(debug::frame().line_count() == 1);
+
+    debug::frame().clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_DEBUGDRAW
+int main()
+{
+    test_line_is_one_pixel_quad();
+    test_zero_length_draws_nothing();
+    test_shapes_line_counts();
+    test_arrow_head_points_back();
+    test_disabled_draws_are_skipped();
+    printf("Test debugdraw complete.\n");
+}
+#endif
@@ -1,18 +1,24 @@
 #include "easing/core.hpp"
-#include "utility/vecref.hpp"
 #include <cassert>
 #include <stdio.h>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
+auto data_of(easing::Easer& easer, easing::Debounce const& debounce) -> easing::DebounceData&
+{
+    return easer.debouncers.at(debounce.handle());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void test_make_debounce_switch_creates_one_element()
 {
     easing::Easer easer;
     auto          debounce = make_debounce_switch(easer, 10);
 
     assert(easer.debouncers.size() == 1);
-    assert(easer.debouncers[0].timeout_ms == 10);
+    assert(data_of(easer, debounce).timeout_ms == 10);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,34 +29,160 @@ void test_get_set_and_step_example()
     auto          debounce = easing::make_debounce_switch(easer, 20);
 
     // Starts in default state.
-    assert(easer.debouncers[0].state == easing::DebounceState::DEFAULT);
+    assert(data_of(easer, debounce).state == easing::DebounceState::DEFAULT);
 
     // Set changes state to running.
     debounce.set(true);
-    assert(easer.debouncers[0].state == easing::DebounceState::RUNNING);
+    assert(data_of(easer, debounce).state == easing::DebounceState::RUNNING);
 
     // Stepping decreases time.
     easer.step(10);
-    assert(easer.debouncers[0].time_ms == 10);
+    assert(easer.remaining_ms(data_of(easer, debounce)) == 10);
 
     // Getting after set returns true.
     auto value = debounce.get();
-    assert(easer.debouncers[0].state == easing::DebounceState::RUNNING_GOT);
+    assert(data_of(easer, debounce).state == easing::DebounceState::RUNNING_GOT);
     assert(value);
 
     // Getting for a second time returns false.
     auto value_2nd = debounce.get();
-    assert(easer.debouncers[0].state == easing::DebounceState::RUNNING_GOT);
+    assert(data_of(easer, debounce).state == easing::DebounceState::RUNNING_GOT);
     assert(!value_2nd);
 
     // When time reaches zero enters default state.
     easer.step(10);
-    assert(easer.debouncers[0].time_ms == 0);
-    assert(easer.debouncers[0].state == easing::DebounceState::DEFAULT);
+    assert(easer.remaining_ms(data_of(easer, debounce)) == 0);
+    assert(data_of(easer, debounce).state == easing::DebounceState::DEFAULT);
 
     // check does not decrement further.
     easer.step(100);
-    assert(easer.debouncers[0].time_ms == 0);
+    assert(easer.remaining_ms(data_of(easer, debounce)) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_step_only_expires_running_debouncers()
+{
+    easing::Easer easer;
+    auto          short_debounce = easing::make_debounce_switch(easer, 10);
+    auto          long_debounce  = easing::make_debounce_switch(easer, 30);
+    auto          idle_debounce  = easing::make_debounce_switch(easer, 10);
+
+    short_debounce.set(true);
+    long_debounce.set(true);
+    assert(easer.timers.size() == 2);
+
+    easer.step(15);
+    assert(data_of(easer, short_debounce).state == easing::DebounceState::DEFAULT);
+    assert(data_of(easer, long_debounce).state == easing::DebounceState::RUNNING);
+    assert(data_of(easer, idle_debounce).state == easing::DebounceState::DEFAULT);
+    assert(easer.remaining_ms(data_of(easer, long_debounce)) == 15);
+    assert(easer.timers.size() == 1);
+
+    // Can be set again once expired.
+    assert(short_debounce.set(true));
+    assert(!long_debounce.set(true));
+
+    easer.step(15);
+    assert(data_of(easer, short_debounce).state == easing::DebounceState::DEFAULT);
+    assert(data_of(easer, long_debounce).state == easing::DebounceState::DEFAULT);
+    assert(easer.timers.size() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_last_debounce_releases_slot()
+{
+    easing::Easer easer;
+    {
+        auto debounce = easing::make_debounce_switch(easer, 10);
+        auto copy     = debounce;
+        debounce.set(true);
+        assert(easer.debouncers.size() == 1);
+        assert(data_of(easer, copy).ref_count == 2);
+    }
+
+    // Both copies destroyed, the slot and the running timer are released.
+    assert(easer.debouncers.size() == 0);
+    assert(easer.timers.size() == 0);
+}
+
+void test_transient_debouncers_do_not_grow()
+{
+    easing::Easer easer;
+    auto          persistent = easing::make_debounce_switch(easer, 10);
+
+    for (int tick = 0; tick < 1000; ++tick)
+    {
+        auto transient = easing::make_debounce_switch(easer, 50);
+        transient.set(true);
+        easer.step(1);
+    }
+
+    assert(easer.debouncers.size() == 1);
+    assert(easer.debouncers.capacity() == 2);
+    assert(easer.timers.size() == 0);
+}
+
+void test_copy_assignment_releases_old_slot()
+{
+    easing::Easer easer;
+    auto          a        = easing::make_debounce_switch(easer, 10);
+    auto          b        = easing::make_debounce_switch(easer, 20);
+    auto          b_handle = b.handle();
+
+    b = a;
+    assert(easer.debouncers.size() == 1);
+    assert(!easer.debouncers.contains(b_handle));
+    assert(data_of(easer, a).ref_count == 2);
+
+    // Self assignment keeps the count.
+    b = b;
+    assert(data_of(easer, a).ref_count == 2);
+}
+
+void test_stale_handle_is_detected()
+{
+    easing::Easer          easer;
+    easing::DebounceHandle stale;
+    {
+        auto debounce = easing::make_debounce_switch(easer, 10);
+        stale         = debounce.handle();
+    }
+    auto reused = easing::make_debounce_switch(easer, 10);
+
+    assert(reused.handle().index == stale.index);
+    assert(!easer.debouncers.contains(stale));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_timer_wheel_expires_in_order()
+{
+    easing::TimerWheel  wheel;
+    std::vector<uint32> fired;
+
+    wheel.schedule(5000, 3);
+    wheel.schedule(70, 2);
+    wheel.schedule(1, 1);
+    auto cancelled = wheel.schedule(100, 4);
+
+    assert(wheel.cancel(cancelled));
+    assert(!wheel.cancel(cancelled));
+
+    wheel.advance(69, [&fired](uint32 payload) { fired.push_back(payload); });
+    assert(fired.size() == 1);
+    assert(fired[0] == 1);
+
+    wheel.advance(1, [&fired](uint32 payload) { fired.push_back(payload); });
+    assert(fired.size() == 2);
+    assert(fired[1] == 2);
+
+    wheel.advance(10000, [&fired](uint32 payload) { fired.push_back(payload); });
+    assert(fired.size() == 3);
+    assert(fired[2] == 3);
+    assert(wheel.now() == 10070);
+    assert(wheel.size() == 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,6 +192,12 @@ int main()
 {
     test_make_debounce_switch_creates_one_element();
     test_get_set_and_step_example();
+    test_step_only_expires_running_debouncers();
+    test_last_debounce_releases_slot();
+    test_transient_debouncers_do_not_grow();
+    test_copy_assignment_releases_old_slot();
+    test_stale_handle_is_detected();
+    test_timer_wheel_expires_in_order();
     printf("Test easing complete.\n");
 }
 #endif
@@ -44,12 +44,32 @@ void test_rfinds_1s()
     assert(indices[2] == 1);
 }
 
+void test_finds_into_reused_results()
+{
+    auto v = make_vector_01110();
+
+    std::vector<std::size_t> indices{9, 9, 9, 9, 9, 9};
+    auto const               capacity = indices.capacity();
+
+    auto ones = [](int x) { return x == 1; };
+    algorithm::find_indices(v, ones, indices);
+    assert(indices.size() == 3);
+    assert(indices[0] == 1);
+    assert(indices[2] == 3);
+
+    auto twos = [](int x) { return x == 2; };
+    algorithm::find_indices(v, twos, indices);
+    assert(indices.empty());
+    assert(indices.capacity() == capacity);
+}
+
 #ifdef TEST_ALGO_FIND
 int main()
 {
     test_finds_1s();
     test_finds_0s();
     test_rfinds_1s();
+    test_finds_into_reused_results();
 
     printf("Test algorithm::find_indices complete.\n");
 
@@ -0,0 +1,103 @@
+#include "containers/frame_arena.hpp"
+#include "debug/allocations.hpp"
+#include <cassert>
+#include <cstdint>
+#include <stdio.h>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_allocations_are_bumps()
+{
+    frame_arena arena(1024);
+
+    auto const start = debug::thread_allocations();
+    {
+        std::pmr::vector<int> values(&arena);
+        values.reserve(16);
+        for (int i = 0; i < 16; ++i)
+        {
+            values.push_back(i);
+        }
+        assert(values[15] == 15);
+    }
+
+    // Nothing went to operator new, and freeing gave nothing back.
+    assert(debug::allocations_since(start).count == 0);
+    assert(arena.used() == 16 * sizeof(int));
+    assert(arena.overflows() == 0);
+}
+
+void test_reset_reuses_the_buffer()
+{
+    frame_arena arena(1024);
+
+    void* first = arena.allocate(100, 8);
+    arena.reset();
+    assert(arena.used() == 0);
+
+    void* again = arena.allocate(100, 8);
+    assert(first == again);
+}
+
+void test_allocations_are_aligned()
+{
+    frame_arena arena(1024);
+
+    (void)arena.allocate(1, 1);
+    void* p = arena.allocate(32, 32);
+    assert((reinterpret_cast<std::uintptr_t>(p) % 32) == 0);
+
+    void* q = arena.allocate(0, 8);
+    assert(q != nullptr);
+    assert((reinterpret_cast<std::uintptr_t>(q) % 8) == 0);
+}
+
+void test_high_water_mark()
+{
+    frame_arena arena(1024);
+
+    (void)arena.allocate(300, 1);
+    arena.reset();
+    (void)arena.allocate(100, 1);
+    assert(arena.high_water_mark() == 300);
+    arena.reset();
+
+    (void)arena.allocate(500, 1);
+    assert(arena.high_water_mark() == 500);
+    arena.reset();
+    assert(arena.high_water_mark() == 500);
+}
+
+void test_overflow_goes_upstream()
+{
+    frame_arena arena(64);
+
+    std::pmr::vector<char> small(&arena);
+    small.reserve(32);
+    assert(arena.used() == 32);
+
+    {
+        std::pmr::vector<char> large(&arena);
+        large.resize(1000, 'x');
+        assert(large[999] == 'x');
+        assert(arena.overflows() == 1);
+    }
+
+    // The overflow was given back upstream, the arena is untouched.
+    assert(arena.used() == 32);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_FRAME_ARENA
+int main()
+{
+    test_allocations_are_bumps();
+    test_reset_reuses_the_buffer();
+    test_allocations_are_aligned();
+    test_high_water_mark();
+    test_overflow_goes_upstream();
+    printf("Test frame arena complete.\n");
+}
+#endif
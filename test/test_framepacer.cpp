@@ -0,0 +1,113 @@
+#include "framepacer.hpp"
+#include <cassert>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_cheap_frames_keep_full_rate()
+{
+    RateAdapter adapter;
+    for (int i = 0; i < 200; ++i)
+    {
+        assert(adapter.update(0.004, 1.0 / 60) == 1);
+    }
+}
+
+void test_expensive_frames_step_down()
+{
+    RateAdapter adapter;
+
+    // 20ms frames do not fit 16.7ms, but do fit 33.3ms.
+    for (int i = 0; i < 200; ++i)
+    {
+        adapter.update(0.020, 1.0 / 60);
+    }
+    assert(adapter.divisor == 2);
+
+    // Never slower than a quarter of the target rate.
+    for (int i = 0; i < 200; ++i)
+    {
+        adapter.update(1.0, 1.0 / 60);
+    }
+    assert(adapter.divisor == RateAdapter::MAX_DIVISOR);
+}
+
+void test_steps_back_up_only_after_calm_frames()
+{
+    RateAdapter adapter;
+    for (int i = 0; i < 200; ++i)
+    {
+        adapter.update(0.020, 1.0 / 60);
+    }
+    assert(adapter.divisor == 2);
+
+    // Let the smoothed cost settle on cheap frames, then count.
+    int frames = 0;
+    while (adapter.divisor == 2)
+    {
+        adapter.update(0.002, 1.0 / 60);
+        ++frames;
+        assert(frames < 1000);
+    }
+    assert(adapter.divisor == 1);
+    assert(frames >= RateAdapter::CALM_FRAMES);
+}
+
+void test_paces_to_target()
+{
+    // Frames that do no work still take about a period each.
+    FramePacer pacer(200.0);
+
+    pacer.begin_frame();
+    auto const start = FramePacer::clock::now();
+    for (int i = 0; i < 20; ++i)
+    {
+        pacer.begin_frame();
+        pacer.begin_present();
+        pacer.end_frame();
+    }
+    double const seconds = std::chrono::duration<double>(FramePacer::clock::now() - start).count();
+
+    // 20 frames at 5ms, loose bounds for a busy machine.
+    assert(seconds > 0.095);
+    assert(seconds < 0.5);
+    assert(pacer.spin_margin() >= 0.00025);
+    assert(pacer.spin_margin() <= 0.003);
+}
+
+void test_report_covers_a_second()
+{
+    FramePacer pacer(100.0);
+
+    auto const start = FramePacer::clock::now();
+    while ((FramePacer::clock::now() - start) < std::chrono::milliseconds(1100))
+    {
+        pacer.begin_frame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        pacer.begin_present();
+        pacer.end_frame();
+    }
+
+    auto const& report = pacer.report();
+    assert(report.frames > 50);
+    assert(report.frames <= 101);
+    assert(report.frame_ms() >= 2.f);
+    assert(report.idle_percent() > 0.f);
+    assert(report.idle_percent() < 100.f);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_FRAMEPACER
+int main()
+{
+    test_cheap_frames_keep_full_rate();
+    test_expensive_frames_step_down();
+    test_steps_back_up_only_after_calm_frames();
+    test_paces_to_target();
+    test_report_covers_a_second();
+    printf("Test frame pacer complete.\n");
+}
+#endif
@@ -0,0 +1,111 @@
+#include "debug/counters.hpp"
+#include "debug/histogram.hpp"
+#include "debug/hitch.hpp"
+#include <cassert>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_buckets_cover_their_values()
+{
+    using debug::LogLinearBuckets;
+
+    for (uint32 value = 0; value < 100'000; ++value)
+    {
+        std::size_t const index = LogLinearBuckets::index(value);
+        assert(index < LogLinearBuckets::COUNT);
+        assert(value <= LogLinearBuckets::highest(index));
+
+        // Never more than 1/16th above the value.
+        assert(LogLinearBuckets::highest(index) - value <= value / 16);
+        if (index > 0)
+        {
+            assert(value > LogLinearBuckets::highest(index - 1));
+        }
+    }
+
+    assert(LogLinearBuckets::index(LogLinearBuckets::MAX_VALUE) == LogLinearBuckets::COUNT - 1);
+    assert(LogLinearBuckets::index(0xffff'ffff) == LogLinearBuckets::COUNT - 1);
+    assert(LogLinearBuckets::highest(LogLinearBuckets::COUNT - 1) == LogLinearBuckets::MAX_VALUE);
+}
+
+void test_percentiles()
+{
+    debug::RollingHistogram<1000> histogram;
+    assert(histogram.percentile(0.5) == 0);
+
+    // 990 frames at 16ms, 9 at 40ms and one at 200ms.
+    for (int i = 0; i < 990; ++i)
+    {
+        histogram.add(16'000);
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+        histogram.add(40'000);
+    }
+    histogram.add(200'000);
+
+    auto const p = histogram.percentiles();
+    assert(p.p50 >= 16.f && p.p50 < 17.f);
+    assert(p.p95 >= 16.f && p.p95 < 17.f);
+    assert(p.p99 >= 16.f && p.p99 < 17.f);
+    assert(p.p999 >= 40.f && p.p999 < 42.5f);
+    assert(histogram.percentile(1.0) >= 200'000);
+}
+
+void test_window_forgets_old_values()
+{
+    debug::RollingHistogram<100> histogram;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        histogram.add_seconds(0.1);
+    }
+    assert(histogram.percentile(0.5) >= 100'000);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        histogram.add_seconds(0.001);
+    }
+    assert(histogram.size() == 100);
+    assert(histogram.percentile(1.0) < 1100);
+}
+
+void test_hitch_capture()
+{
+    debug::Profiler        profiler;
+    debug::TelemetryWriter telemetry;
+    debug::HitchCapture    hitches("test_histogram_hitch", 0.05);
+
+    profiler.record("work", 0, 1000, 0);
+    profiler.end_frame();
+    telemetry.write({'f', 1, 0, {}});
+
+    assert(!hitches.check(0.016, profiler, telemetry));
+    assert(hitches.check(0.1, profiler, telemetry));
+
+    // Within the cooldown.
+    assert(!hitches.check(0.1, profiler, telemetry));
+    assert(hitches.capture_count() == 1);
+
+    FILE* trace = fopen("test_histogram_hitch_1.json", "r");
+    FILE* csv   = fopen("test_histogram_hitch_1.csv", "r");
+    assert(trace != nullptr && csv != nullptr);
+    fclose(trace);
+    fclose(csv);
+    remove("test_histogram_hitch_1.json");
+    remove("test_histogram_hitch_1.csv");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_HISTOGRAM
+int main()
+{
+    test_buckets_cover_their_values();
+    test_percentiles();
+    test_window_forgets_old_values();
+    test_hitch_capture();
+    printf("Test histogram complete.\n");
+}
+#endif
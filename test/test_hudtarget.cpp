@@ -0,0 +1,40 @@
+#include "drawing/hudtarget.hpp"
+#include <cassert>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_viewport_at_origin_is_the_texture()
+{
+    SDL_Rect const viewport = drawing::hud_viewport(SDL_Rect{0, 0, 200, 100});
+
+    assert(viewport.x == 0 && viewport.y == 0);
+    assert(viewport.w == 200 && viewport.h == 100);
+}
+
+void test_viewport_maps_window_onto_texture()
+{
+    SDL_Rect const window{300, 40, 200, 100};
+    SDL_Rect const viewport = drawing::hud_viewport(window);
+
+    // The window's top left corner lands on the texture's.
+    assert(window.x + viewport.x == 0);
+    assert(window.y + viewport.y == 0);
+
+    // Its bottom right corner lands on the texture's, so nothing in the
+    // window is clipped by the viewport.
+    assert(window.x + window.w + viewport.x == window.w);
+    assert(viewport.x + viewport.w == window.w);
+    assert(viewport.y + viewport.h == window.h);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_HUDTARGET
+int main()
+{
+    test_viewport_at_origin_is_the_texture();
+    test_viewport_maps_window_onto_texture();
+    printf("Test hud target complete.\n");
+}
+#endif
@@ -0,0 +1,112 @@
+#include "inputqueue.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_ring_is_fifo_and_drops_when_full()
+{
+    spsc_ring<int, 4> ring;
+    assert(ring.front() == nullptr);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(ring.push(i));
+    }
+    assert(!ring.push(4));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(*ring.front() == i);
+        ring.pop();
+    }
+    assert(ring.front() == nullptr);
+
+    // Positions wrap around the slots.
+    for (int i = 0; i < 10; ++i)
+    {
+        assert(ring.push(i));
+        assert(*ring.front() == i);
+        ring.pop();
+    }
+}
+
+void test_ring_across_threads()
+{
+    spsc_ring<int, 64> ring;
+    int const          count = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < count;)
+        {
+            if (ring.push(i))
+            {
+                ++i;
+            }
+        }
+    });
+
+    for (int expected = 0; expected < count;)
+    {
+        if (int const* value = ring.front())
+        {
+            assert(*value == expected);
+            ring.pop();
+            ++expected;
+        }
+    }
+
+    producer.join();
+}
+
+void test_sample_stops_at_window()
+{
+    InputQueue queue;
+    queue.push({10, Key::LEFT, true});
+    queue.push({20, Key::UP, true});
+    queue.push({30, Key::LEFT, false});
+
+    KeySampler keys;
+    assert(keys.sample(queue, 5) == 0);
+    assert(!keys.down(Key::LEFT));
+
+    assert(keys.sample(queue, 20) == 10);
+    assert(keys.down(Key::LEFT));
+    assert(keys.down(Key::UP));
+
+    // The release is still queued, nothing new for this window.
+    assert(keys.sample(queue, 25) == 0);
+    assert(keys.down(Key::LEFT));
+
+    assert(keys.sample(queue, 40) == 30);
+    assert(!keys.down(Key::LEFT));
+    assert(keys.down(Key::UP));
+}
+
+void test_tap_within_a_window_is_seen_once()
+{
+    InputQueue queue;
+    queue.push({10, Key::FIRE, true});
+    queue.push({12, Key::FIRE, false});
+
+    KeySampler keys;
+    keys.sample(queue, 50);
+    assert(keys.down(Key::FIRE));
+
+    keys.sample(queue, 100);
+    assert(!keys.down(Key::FIRE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_INPUTQUEUE
+int main()
+{
+    test_ring_is_fifo_and_drops_when_full();
+    test_ring_across_threads();
+    test_sample_stops_at_window();
+    test_tap_within_a_window_is_seen_once();
+    printf("Test input queue complete.\n");
+}
+#endif
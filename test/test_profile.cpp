@@ -0,0 +1,199 @@
+#include "debug/profile.hpp"
+#include <cassert>
+#include <cstring>
+#include <stdio.h>
+#include <string>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_scopes_nest()
+{
+    debug::Profiler profiler;
+
+    {
+        debug::ProfileScope outer("outer", profiler);
+        {
+            debug::ProfileScope inner("inner", profiler);
+        }
+    }
+    profiler.end_frame();
+
+    std::vector<debug::ScopeAverage> averages;
+    profiler.averages(averages);
+    assert(averages.size() == 2);
+
+    // The outer scope contains the inner one.
+    assert(std::strcmp(averages[0].name, "outer") == 0);
+    assert(averages[0].ms >= averages[1].ms);
+    assert(averages[0].calls == 1.0);
+}
+
+void test_averages_are_per_frame()
+{
+    debug::Profiler profiler;
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            profiler.record("work", 0, 2'000'000, 0); // 2ms.
+        }
+        profiler.end_frame();
+    }
+
+    std::vector<debug::ScopeAverage> averages;
+    profiler.averages(averages);
+    assert(averages.size() == 1);
+    assert(averages[0].calls == 3.0);
+    assert(averages[0].ms > 5.99 && averages[0].ms < 6.01);
+}
+
+void test_keeps_last_frames()
+{
+    debug::Profiler profiler;
+
+    for (std::size_t frame = 0; frame < debug::Profiler::FRAMES + 10; ++frame)
+    {
+        profiler.record("work", 0, 1000, 0);
+        profiler.end_frame();
+    }
+    assert(profiler.frame_count() == debug::Profiler::FRAMES);
+}
+
+void test_full_ring_drops()
+{
+    debug::Profiler profiler;
+
+    for (std::size_t i = 0; i < debug::Profiler::RING_SIZE + 5; ++i)
+    {
+        profiler.record("work", 0, 1, 0);
+    }
+    assert(profiler.dropped() == 5);
+
+    profiler.end_frame();
+    std::vector<debug::ScopeAverage> averages;
+    profiler.averages(averages);
+    assert(averages[0].calls == double(debug::Profiler::RING_SIZE));
+}
+
+void test_threads_record_to_their_own_rings()
+{
+    debug::Profiler profiler;
+
+    std::thread worker([&] {
+        profiler.name_thread("worker");
+        for (int i = 0; i < 1000; ++i)
+        {
+            debug::ProfileScope scope("worker scope", profiler);
+        }
+    });
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        debug::ProfileScope scope("main scope", profiler);
+        if ((i % 100) == 0)
+        {
+            profiler.end_frame();
+        }
+    }
+
+    worker.join();
+    profiler.end_frame();
+
+    std::vector<debug::ScopeAverage> averages;
+    profiler.averages(averages);
+    assert(averages.size() == 2);
+
+    double calls = 0;
+    for (auto const& average : averages)
+    {
+        calls += average.calls * static_cast<double>(profiler.frame_count());
+    }
+    assert(calls > 1999.0 && calls < 2001.0);
+}
+
+namespace {
+
+auto read_file(char const* path) -> std::string
+{
+    FILE* file = fopen(path, "r");
+    assert(file != nullptr);
+
+    std::string text;
+    char        buffer[256];
+    while (fgets(buffer, sizeof(buffer), file) != nullptr)
+    {
+        text += buffer;
+    }
+    fclose(file);
+    return text;
+}
+
+}
+
+void test_chrome_trace()
+{
+    debug::Profiler profiler;
+    profiler.name_thread("main");
+    profiler.record("first", 1000, 3000, 0);
+    profiler.record("second", 1500, 2500, 1);
+    profiler.end_frame();
+
+    char const* path = "test_profile_trace.json";
+    assert(profiler.write_chrome_trace(path));
+
+    std::string const text = read_file(path);
+    remove(path);
+
+    assert(text.find("\"traceEvents\"") != std::string::npos);
+    assert(text.find("\"thread_name\"") != std::string::npos);
+    assert(text.find("{\"name\":\"first\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":2.000}") != std::string::npos);
+    assert(text.find("\"ts\":0.500,\"dur\":1.000") != std::string::npos);
+}
+
+void test_thread_keeps_one_ring_per_profiler()
+{
+    debug::Profiler first;
+    debug::Profiler second;
+    first.name_thread("main");
+
+    // Switching back and forth must not give the thread a new ring, or a
+    // new trace thread, each time.
+    for (int i = 0; i < 100; ++i)
+    {
+        debug::ProfileScope a("first", first);
+        debug::ProfileScope b("second", second);
+    }
+    first.end_frame();
+    second.end_frame();
+
+    char const* path = "test_profile_rings.json";
+    assert(first.write_chrome_trace(path));
+    std::string const text = read_file(path);
+    remove(path);
+
+    assert(text.find("\"tid\":0") != std::string::npos);
+    assert(text.find("\"tid\":1") == std::string::npos);
+
+    std::vector<debug::ScopeAverage> averages;
+    second.averages(averages);
+    assert(averages.size() == 1);
+    assert(averages[0].calls == 100.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_PROFILE
+int main()
+{
+    test_scopes_nest();
+    test_averages_are_per_frame();
+    test_keeps_last_frames();
+    test_full_ring_drops();
+    test_threads_record_to_their_own_rings();
+    test_chrome_trace();
+    test_thread_keeps_one_ring_per_profiler();
+    printf("Test profile complete.\n");
+}
+#endif
@@ -0,0 +1,141 @@
+#include "gamehud.h"
+#include "propertyeditor.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <vector>
+
+// The rendering side is stubbed out below, the test executables do not link
+// SDL or kiss_sdl. Each stub records what would have been drawn.
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+std::vector<void const*> drawn;      // Widgets, in draw order.
+std::vector<SDL_Rect>    rows_filled; // Row backgrounds cleared.
+
+}
+
+kiss_font  kiss_textfont{};
+kiss_image kiss_normal{};
+int        kiss_screen_width  = 640;
+int        kiss_screen_height = 480;
+
+int kiss_window_new(kiss_window* window, kiss_window*, int, int x, int y, int w, int h)
+{
+    window->rect = SDL_Rect{x, y, w, h};
+    return 0;
+}
+
+int kiss_progressbar_new(kiss_progressbar* bar, kiss_window*, int x, int y, int w)
+{
+    bar->rect = SDL_Rect{x, y, w, 10};
+    return 0;
+}
+
+int kiss_label_draw(kiss_label* label, SDL_Renderer*)
+{
+    drawn.push_back(label);
+    return 1;
+}
+
+int kiss_entry_draw(kiss_entry* entry, SDL_Renderer*)
+{
+    drawn.push_back(entry);
+    return 1;
+}
+
+int kiss_selectbutton_draw(kiss_selectbutton* button, SDL_Renderer*)
+{
+    drawn.push_back(button);
+    return 1;
+}
+
+int SDL_SetRenderDrawColor(SDL_Renderer*, Uint8, Uint8, Uint8, Uint8) { return 0; }
+
+int SDL_RenderFillRect(SDL_Renderer*, SDL_Rect const* rect)
+{
+    rows_filled.push_back(*rect);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_set_widget_text_reports_changes()
+{
+    char text[KISS_MAX_LENGTH] = "";
+
+    assert(set_widget_text(text, 1.5f));
+    assert(std::strcmp(text, "1.5") == 0);
+
+    assert(!set_widget_text(text, 1.5f));
+    assert(set_widget_text(text, 2.f));
+    assert(std::strcmp(text, "2") == 0);
+}
+
+void test_only_changed_rows_redraw()
+{
+    float speed  = 1.f;
+    float health = 0.5f;
+    bool  flag   = false;
+
+    // Read only rows, as the game shows its state.
+    VariadicDataEditor editor(std::tuple{"Speed", static_cast<float const*>(&speed)},
+                              std::tuple{"Health", static_cast<float const*>(&health)},
+                              std::tuple{"Flag", &flag});
+
+    editor.row_rect      = SDL_Rect{0, 0, 100, 50};
+    editor.args.row_rect = SDL_Rect{0, 50, 100, 50};
+
+    // Every row starts dirty, then drawing everything leaves them clean.
+    window_update(editor);
+    window_mark_clean(editor);
+    assert(window_dirty_rows(editor) == 0);
+
+    // Nothing changed, nothing to draw.
+    window_update(editor);
+    assert(window_dirty_rows(editor) == 0);
+
+    // Only the health row changed.
+    drawn.clear();
+    rows_filled.clear();
+    health = 0.25f;
+    window_update(editor);
+    assert(window_dirty_rows(editor) == 1);
+
+    window_draw_dirty(editor, nullptr, SDL_Color{});
+    assert(window_dirty_rows(editor) == 0);
+
+    assert(rows_filled.size() == 1);
+    assert(rows_filled[0].y == 50);
+
+    assert(drawn.size() == 2);
+    assert(drawn[0] == &editor.args.label_widget);
+    assert(drawn[1] == &editor.args.data_widget);
+    assert(std::strcmp(editor.args.data_widget.text, "0.25") == 0);
+}
+
+void test_game_hud_dirty_only_on_change()
+{
+    GameHud hud;
+    hud.dirty = false;
+
+    hud.update(static_cast<float>(hud.hunger_bar.fraction));
+    assert(!hud.dirty);
+
+    hud.update(0.75f);
+    assert(hud.dirty);
+    assert(hud.hunger_bar.fraction == 0.75);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_PROPERTYEDITOR
+int main()
+{
+    test_set_widget_text_reports_changes();
+    test_only_changed_rows_redraw();
+    test_game_hud_dirty_only_on_change();
+    printf("Test property editor complete.\n");
+}
+#endif
@@ -0,0 +1,101 @@
+#include "drawing/shapebatch.hpp"
+#include "shapes.hpp"
+#include <cassert>
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+auto near(float a, float b) -> bool
+{
+    return std::fabs(a - b) < 1e-4f;
+}
+
+}
+
+// The tables are built by the compiler.
+static_assert(UNIT_CIRCLE<4>.x[0] == 1.f);
+static_assert(UNIT_CIRCLE<4>.y[1] > 0.9999f);
+static_assert(UNIT_CIRCLE<4>.x[2] < -0.9999f);
+
+// Nothing but the transform.
+static_assert(sizeof(Shape<32>) == 4 * sizeof(float));
+
+void test_unit_circle_matches_libm()
+{
+    auto const& circle = UNIT_CIRCLE<37>;
+    for (size_t i = 0; i < 37; ++i)
+    {
+        double const theta = (2 * M_PI * i) / 37;
+        assert(near(circle.x[i], static_cast<float>(std::cos(theta))));
+        assert(near(circle.y[i], static_cast<float>(std::sin(theta))));
+    }
+}
+
+void test_shapes_share_points()
+{
+    Shape<16> a(1.f);
+    Shape<16> b(5.f, 10.f, 10.f);
+    assert(&a.points() == &b.points());
+}
+
+void test_affine_points()
+{
+    float const ux[2] = {1.f, 0.f};
+    float const uy[2] = {0.f, 1.f};
+    float       ox[2];
+    float       oy[2];
+
+    // Quarter turn, double size, moved to (10, 20).
+    affine_points(ux, uy, 2, shape_affine(2.f, static_cast<float>(M_PI / 2), 10.f, 20.f), ox, oy);
+
+    assert(near(ox[0], 10.f) && near(oy[0], 22.f));
+    assert(near(ox[1], 8.f) && near(oy[1], 20.f));
+}
+
+void test_batch_is_fans_in_screen_space()
+{
+    std::vector<Shape<8>> shapes;
+    for (int i = 0; i < 1000; ++i)
+    {
+        shapes.emplace_back(10.f, float(i), 100.f);
+    }
+
+    drawing::ShapeBatch batch;
+    batch.add<8>(shapes, {0xff, 0x00, 0x00, 0xff});
+
+    assert(batch.shape_count() == 1000);
+    assert(batch.vertex_list().size() == 1000 * 9);
+    assert(batch.index_list().size() == 1000 * 8 * 3);
+
+    // First shape: center, then the rim from angle 0 counter clockwise, which
+    // is clockwise on screen.
+    auto const& v = batch.vertex_list();
+    assert(near(v[0].position.x, 0.f) && near(v[0].position.y, to_screen_y(100.f)));
+    assert(near(v[1].position.x, 10.f) && near(v[1].position.y, to_screen_y(100.f)));
+    assert(near(v[3].position.x, 0.f) && near(v[3].position.y, to_screen_y(110.f)));
+
+    // Last fan triangle closes back to the first rim point.
+    auto const& indices = batch.index_list();
+    assert(indices[(8 * 3) - 1] == 1);
+    assert(indices[8 * 3] == 9);
+
+    batch.clear();
+    assert(batch.shape_count() == 0 && batch.vertex_list().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_SHAPES
+int main()
+{
+    test_unit_circle_matches_libm();
+    test_shapes_share_points();
+    test_affine_points();
+    test_batch_is_fans_in_screen_space();
+    printf("Test shapes complete.\n");
+}
+#endif
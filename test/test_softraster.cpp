@@ -0,0 +1,151 @@
+#include "drawing/softraster.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+constexpr uint32 CLEAR = 0xff000000;
+
+// Rasterises every tile on this thread.
+auto rasterize(drawing::QuadBatch const& batch, drawing::RasterFrame& frame) -> std::vector<uint32>
+{
+    std::vector<uint32> pixels(static_cast<std::size_t>(frame.width) * frame.height);
+
+    drawing::bin_quads(batch, frame);
+    for (int tile = 0; tile < frame.tile_count(); ++tile)
+    {
+        drawing::rasterize_tile(frame, tile, CLEAR, pixels.data(), frame.width);
+    }
+    return pixels;
+}
+
+auto pixel_at(std::vector<uint32> const& pixels, drawing::RasterFrame const& frame, int x, int y) -> uint32
+{
+    return pixels[(y * frame.width) + x];
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_fill_covers_pixel_centres()
+{
+    drawing::RasterFrame frame;
+    frame.resize(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // World y is flipped, this lands on screen rows 10 to 19.
+    drawing::QuadBatch batch;
+    batch.fill_rect({60.f, to_screen_y(20.f), 10.f, 10.f}, drawing::RED);
+
+    auto pixels = rasterize(batch, frame);
+
+    // Crosses the tile boundary at x = 64.
+    assert(pixel_at(pixels, frame, 60, 10) == 0xffff0000);
+    assert(pixel_at(pixels, frame, 69, 19) == 0xffff0000);
+    assert(pixel_at(pixels, frame, 70, 10) == CLEAR);
+    assert(pixel_at(pixels, frame, 59, 10) == CLEAR);
+    assert(pixel_at(pixels, frame, 60, 20) == CLEAR);
+    assert(pixel_at(pixels, frame, 60, 9) == CLEAR);
+}
+
+void test_later_quads_draw_on_top()
+{
+    drawing::RasterFrame frame;
+    frame.resize(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    drawing::QuadBatch batch;
+    batch.fill_rect({0.f, 0.f, 100.f, 100.f}, drawing::RED);
+    batch.fill_rect({0.f, 0.f, 50.f, 50.f}, drawing::BLUE);
+
+    auto pixels = rasterize(batch, frame);
+
+    int const bottom = SCREEN_HEIGHT - 1;
+    assert(pixel_at(pixels, frame, 10, bottom) == 0xff0000ff);
+    assert(pixel_at(pixels, frame, 75, bottom) == 0xffff0000);
+}
+
+void test_alpha_blends()
+{
+    drawing::RasterFrame frame;
+    frame.resize(64, 64);
+
+    drawing::QuadBatch batch;
+    batch.fill_rect({0.f, 0.f, 1000.f, 1000.f}, {0xff, 0xff, 0xff, 0xff});
+    batch.set_blend_mode(SDL_BLENDMODE_BLEND);
+    batch.fill_rect({0.f, 0.f, 1000.f, 1000.f}, {0x00, 0x00, 0x00, 0x80});
+
+    auto pixels = rasterize(batch, frame);
+
+    uint32 const p = pixel_at(pixels, frame, 0, 0);
+    assert((p >> 24) == 0xff);
+    assert(((p >> 16) & 0xff) == 0x7f);
+}
+
+void test_sprite_samples_texture()
+{
+    // 2x2 texture, one colour per texel.
+    std::vector<uint32> texels{0xff110000, 0xff220000, 0xff330000, 0xff440000};
+    auto*               key = reinterpret_cast<SDL_Texture*>(0x1);
+
+    drawing::RasterFrame frame;
+    frame.resize(64, 64);
+    frame.textures.push_back({key, texels.data(), 2, 2});
+
+    // Scaled up to 20x20 pixels at the top left of the screen.
+    drawing::QuadBatch batch;
+    batch.sprite(key, 2, 2, {0, 0, 2, 2}, {0.f, to_screen_y(20.f), 20.f, 20.f});
+
+    auto pixels = rasterize(batch, frame);
+
+    assert(pixel_at(pixels, frame, 0, 0) == 0xff110000);
+    assert(pixel_at(pixels, frame, 19, 0) == 0xff220000);
+    assert(pixel_at(pixels, frame, 0, 19) == 0xff330000);
+    assert(pixel_at(pixels, frame, 19, 19) == 0xff440000);
+    assert(pixel_at(pixels, frame, 20, 20) == CLEAR);
+}
+
+void test_unknown_textures_are_skipped()
+{
+    drawing::RasterFrame frame;
+    frame.resize(64, 64);
+
+    drawing::QuadBatch batch;
+    batch.sprite(reinterpret_cast<SDL_Texture*>(0x2), 2, 2, {0, 0, 2, 2}, {0.f, 0.f, 2000.f, 2000.f});
+
+    auto pixels = rasterize(batch, frame);
+    assert(frame.quads.empty());
+    assert(pixel_at(pixels, frame, 0, 0) == CLEAR);
+}
+
+void test_offscreen_quads_are_clipped()
+{
+    drawing::RasterFrame frame;
+    frame.resize(64, 64);
+
+    drawing::QuadBatch batch;
+    batch.fill_rect({-1000.f, -1000.f, 10.f, 10.f}, drawing::RED);
+    batch.fill_rect({-10.f, to_screen_y(10.f), 20.f, 20.f}, drawing::RED);
+
+    auto pixels = rasterize(batch, frame);
+    assert(frame.quads.size() == 1);
+    assert(pixel_at(pixels, frame, 0, 0) == 0xffff0000);
+    assert(pixel_at(pixels, frame, 10, 0) == CLEAR);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_SOFTRASTER
+int main()
+{
+    test_fill_covers_pixel_centres();
+    test_later_quads_draw_on_top();
+    test_alpha_blends();
+    test_sprite_samples_texture();
+    test_unknown_textures_are_skipped();
+    test_offscreen_quads_are_clipped();
+    printf("Test softraster complete.\n");
+}
+#endif
@@ -0,0 +1,179 @@
+#include "containers/sparse_set.hpp"
+#include <cassert>
+#include <stdio.h>
+#include <string>
+
+using table = sparse_set<int, std::string>;
+
+auto make_table_abc() -> table
+{
+    table t;
+    t.insert(10, 1, "a");
+    t.insert(3, 2, "b");
+    t.insert(7, 3, "c");
+    return t;
+}
+
+void test_sparse_set_starts_empty()
+{
+    table t;
+    assert(t.size() == 0);
+    assert(t.empty());
+    assert(!t.contains(0));
+}
+
+void test_insert_and_contains()
+{
+    auto t = make_table_abc();
+
+    assert(t.size() == 3);
+    assert(t.contains(10));
+    assert(t.contains(3));
+    assert(t.contains(7));
+    assert(!t.contains(4));
+    assert(!t.contains(1000));
+}
+
+void test_get_by_id()
+{
+    auto t = make_table_abc();
+
+    assert(t.get<0>(3) == 2);
+    assert(t.get<1>(3) == "b");
+    assert(t.get<0>(10) == 1);
+    assert(t.get<1>(7) == "c");
+}
+
+void test_columns_are_packed()
+{
+    auto t = make_table_abc();
+
+    auto const& ints = t.column<0>();
+    auto const& strs = t.column<1>();
+    assert(ints.size() == 3);
+    assert(strs.size() == 3);
+    assert(ints[0] == 1 && strs[0] == "a");
+    assert(ints[1] == 2 && strs[1] == "b");
+    assert(ints[2] == 3 && strs[2] == "c");
+}
+
+void test_erase_keeps_columns_aligned()
+{
+    auto t = make_table_abc();
+
+    // Removing the first row moves the last row into its place.
+    assert(t.erase(10));
+    assert(t.size() == 2);
+    assert(!t.contains(10));
+
+    assert(t.id_at(0) == 7);
+    assert(t.column<0>()[0] == 3);
+    assert(t.column<1>()[0] == "c");
+
+    assert(t.get<0>(7) == 3);
+    assert(t.get<1>(7) == "c");
+    assert(t.get<0>(3) == 2);
+    assert(t.get<1>(3) == "b");
+}
+
+void test_erase_last_row()
+{
+    auto t = make_table_abc();
+
+    assert(t.erase(7));
+    assert(t.size() == 2);
+    assert(t.get<1>(10) == "a");
+    assert(t.get<1>(3) == "b");
+}
+
+void test_erase_missing_id_does_nothing()
+{
+    auto t = make_table_abc();
+
+    assert(!t.erase(4));
+    assert(!t.erase(1000));
+    assert(t.size() == 3);
+}
+
+void test_reinsert_after_erase()
+{
+    auto t = make_table_abc();
+
+    t.erase(3);
+    t.insert(3, 4, "d");
+    assert(t.size() == 3);
+    assert(t.get<0>(3) == 4);
+    assert(t.get<1>(3) == "d");
+}
+
+void test_duplicate_insert_throws()
+{
+    auto t     = make_table_abc();
+    bool threw = false;
+    try
+    {
+        t.insert(3, 4, "d");
+    }
+    catch (std::invalid_argument const&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(t.get<0>(3) == 2);
+}
+
+void test_clear()
+{
+    auto t = make_table_abc();
+
+    t.clear();
+    assert(t.empty());
+    assert(!t.contains(3));
+    assert(t.column<1>().empty());
+}
+
+void test_version_changes_on_modification()
+{
+    auto t = make_table_abc();
+    auto v = t.version();
+
+    t.get<0>(3) = 10;
+    assert(t.version() == v);
+
+    t.touch();
+    assert(t.version() != v);
+
+    v = t.version();
+    t.erase(42);
+    assert(t.version() == v);
+
+    t.erase(3);
+    assert(t.version() != v);
+
+    v = t.version();
+    t.insert(3, 2, "c");
+    assert(t.version() != v);
+
+    v = t.version();
+    t.clear();
+    assert(t.version() != v);
+}
+
+#ifdef TEST_SPARSE_SET
+int main()
+{
+    test_sparse_set_starts_empty();
+    test_insert_and_contains();
+    test_get_by_id();
+    test_columns_are_packed();
+    test_erase_keeps_columns_aligned();
+    test_erase_last_row();
+    test_erase_missing_id_does_nothing();
+    test_reinsert_after_erase();
+    test_duplicate_insert_throws();
+    test_clear();
+    test_version_changes_on_modification();
+    printf("TEST_SPARSE_SET complete.\n");
+    return 0;
+}
+#endif
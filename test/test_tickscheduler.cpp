@@ -0,0 +1,119 @@
+#include "tickscheduler.hpp"
+#include <cassert>
+#include <chrono>
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using clock_type = TickScheduler::clock;
+using ms         = std::chrono::milliseconds;
+
+void test_on_time_wakes_run_one_tick()
+{
+    auto const    start = clock_type::time_point{};
+    TickScheduler scheduler(ms(50), start);
+
+    assert(scheduler.due(start + ms(10)) == 0);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        auto const now = start + ms(50 * i);
+        assert(scheduler.next_tick() == now);
+        assert(scheduler.due(now) == 1);
+        scheduler.ran(now + ms(2));
+    }
+
+    assert(scheduler.totals().late_ticks == 0);
+    assert(scheduler.totals().dropped_ticks == 0);
+}
+
+void test_short_stall_is_caught_up()
+{
+    auto const    start = clock_type::time_point{};
+    TickScheduler scheduler(ms(50), start);
+
+    // Woke 120ms late, three ticks are due.
+    auto const now = start + ms(170);
+    assert(scheduler.due(now) == 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        scheduler.ran(now);
+    }
+
+    assert(scheduler.next_tick() == start + ms(200));
+    assert(scheduler.totals().late_ticks == 2);
+    assert(scheduler.totals().dropped_ticks == 0);
+}
+
+void test_long_stall_is_dropped()
+{
+    auto const    start = clock_type::time_point{};
+    TickScheduler scheduler(ms(50), start);
+
+    // A second late: the ticks due at 50ms to 1050ms, only MAX_CATCH_UP run.
+    auto const now = start + ms(1050);
+    assert(scheduler.due(now) == TickScheduler::MAX_CATCH_UP);
+    assert(scheduler.totals().dropped_ticks == 21 - TickScheduler::MAX_CATCH_UP);
+
+    for (int i = 0; i < TickScheduler::MAX_CATCH_UP; ++i)
+    {
+        scheduler.ran(now);
+    }
+
+    // Caught up to real time, the next tick is a period away.
+    assert(scheduler.next_tick() == start + ms(1100));
+    assert(scheduler.due(now) == 0);
+}
+
+void test_over_budget_after_a_period()
+{
+    auto const    start = clock_type::time_point{};
+    TickScheduler scheduler(ms(50), start);
+
+    assert(!scheduler.over_budget(start, start + ms(49)));
+    assert(scheduler.over_budget(start, start + ms(50)));
+}
+
+void test_sustained_overload_does_not_spiral()
+{
+    auto const    start = clock_type::time_point{};
+    TickScheduler scheduler(ms(50), start);
+
+    // Every tick costs 80ms, more than its period. Each wake stops at the
+    // budget, so the backlog is dropped instead of growing.
+    auto now = start + ms(50);
+    for (int wake = 0; wake < 100; ++wake)
+    {
+        auto const woke = now;
+        int const  due  = scheduler.due(woke);
+        assert(due <= TickScheduler::MAX_CATCH_UP);
+
+        for (int i = 0; i < due; ++i)
+        {
+            now += ms(80);
+            scheduler.ran(now);
+            if (scheduler.over_budget(woke, now))
+            {
+                break;
+            }
+        }
+
+        assert((now - scheduler.next_tick()) < ms(50 * (TickScheduler::MAX_CATCH_UP + 1)));
+    }
+
+    assert(scheduler.totals().dropped_ticks > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_TICKSCHEDULER
+int main()
+{
+    test_on_time_wakes_run_one_tick();
+    test_short_stall_is_caught_up();
+    test_long_stall_is_dropped();
+    test_over_budget_after_a_period();
+    test_sustained_overload_does_not_spiral();
+    printf("Test tick scheduler complete.\n");
+}
+#endif
@@ -0,0 +1,100 @@
+#include "containers/triple_buffer.hpp"
+#include <array>
+#include <cassert>
+#include <stdio.h>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_nothing_to_read_before_publish()
+{
+    triple_buffer<int> tb(7);
+    assert(!tb.update());
+    assert(tb.read_buffer() == 7);
+}
+
+void test_reader_sees_latest_publish()
+{
+    triple_buffer<int> tb;
+
+    tb.write_buffer() = 1;
+    tb.publish();
+    tb.write_buffer() = 2;
+    tb.publish();
+
+    // 1 is skipped.
+    assert(tb.update());
+    assert(tb.read_buffer() == 2);
+
+    // Nothing new, the reader keeps what it has.
+    assert(!tb.update());
+    assert(tb.read_buffer() == 2);
+}
+
+void test_writer_never_gets_the_read_slot()
+{
+    triple_buffer<int> tb;
+
+    tb.write_buffer() = 1;
+    tb.publish();
+    assert(tb.update());
+
+    int const* reading = &tb.read_buffer();
+    for (int i = 0; i < 10; ++i)
+    {
+        assert(&tb.write_buffer() != reading);
+        tb.write_buffer() = 100 + i;
+        tb.publish();
+    }
+    assert(*reading == 1);
+}
+
+void test_threads_see_whole_values_in_order()
+{
+    // Every element holds the same count, a torn read would mix counts.
+    using block = std::array<int, 64>;
+
+    constexpr int count = 200000;
+
+    triple_buffer<block> tb(block{});
+
+    std::thread writer([&tb] {
+        for (int i = 1; i <= count; ++i)
+        {
+            tb.write_buffer().fill(i);
+            tb.publish();
+        }
+    });
+
+    int last = 0;
+    while (last < count)
+    {
+        if (!tb.update())
+        {
+            continue;
+        }
+
+        auto const& value = tb.read_buffer();
+        for (int element : value)
+        {
+            assert(element == value[0]);
+        }
+        assert(value[0] > last);
+        last = value[0];
+    }
+
+    writer.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_TRIPLE_BUFFER
+int main()
+{
+    test_nothing_to_read_before_publish();
+    test_reader_sees_latest_publish();
+    test_writer_never_gets_the_read_slot();
+    test_threads_see_whole_values_in_order();
+    printf("Test triple buffer complete.\n");
+}
+#endif
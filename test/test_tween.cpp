@@ -0,0 +1,222 @@
+#include "debug/allocations.hpp"
+#include "easing/core.hpp"
+#include <cassert>
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+auto near(float a, float b) -> bool
+{
+    return std::abs(a - b) < 1e-3f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void test_linear_tween_reaches_target()
+{
+    easing::Easer easer;
+    float         value = 0.f;
+
+    easing::tween(easer, &value, 10.f, 100);
+    assert(easer.tweens.size() == 1);
+
+    easer.step(50);
+    assert(near(value, 5.f));
+
+    easer.step(50);
+    assert(value == 10.f);
+    assert(easer.tweens.size() == 0);
+
+    // Finished tweens no longer write to the target.
+    value = 3.f;
+    easer.step(50);
+    assert(value == 3.f);
+}
+
+void test_curves_start_and_end_on_their_endpoints()
+{
+    for (int c = 0; c < easing::CURVE_COUNT; ++c)
+    {
+        auto curve = static_cast<easing::Curve>(c);
+        auto end   = (curve == easing::Curve::SHAKE) ? 0.f : 1.f;
+
+        assert(near(easing::evaluate_curve(curve, 0.f), 0.f));
+        assert(near(easing::evaluate_curve(curve, 1.f), end));
+    }
+}
+
+void test_lookup_matches_curve()
+{
+    easing::Easer easer;
+    float         value = 0.f;
+
+    easing::tween(easer, &value, 1.f, 1000, easing::Curve::CUBIC_IN_OUT);
+    easer.step(300);
+    assert(near(value, easing::evaluate_curve(easing::Curve::CUBIC_IN_OUT, 0.3f)));
+}
+
+void test_shake_returns_to_start()
+{
+    easing::Easer easer;
+    float         offset = 2.f;
+
+    easer.tweens.add(&offset, 2.f, 5.f, 100, easing::Curve::SHAKE);
+    easer.step(10);
+    assert(!near(offset, 2.f));
+
+    easer.step(100);
+    assert(near(offset, 2.f));
+}
+
+void test_retarget_replaces_running_tween()
+{
+    easing::Easer easer;
+    float         value = 0.f;
+
+    easing::tween(easer, &value, 10.f, 100);
+    easer.step(50);
+    easing::tween(easer, &value, 0.f, 100);
+    assert(easer.tweens.size() == 1);
+
+    easer.step(100);
+    assert(value == 0.f);
+}
+
+void test_vec2_tween_and_cancel()
+{
+    easing::Easer easer;
+    float         x = 0.f;
+    float         y = 0.f;
+
+    easing::tween(easer, &x, &y, 4.f, -4.f, 40);
+    easer.step(10);
+    assert(near(x, 1.f));
+    assert(near(y, -1.f));
+
+    assert(easer.tweens.cancel(&x));
+    assert(!easer.tweens.cancel(&x));
+
+    easer.step(30);
+    assert(near(x, 1.f));
+    assert(y == -4.f);
+}
+
+void test_retarget_after_swap_remove()
+{
+    easing::Easer easer;
+    float         a = 0.f;
+    float         b = 0.f;
+    float         c = 0.f;
+
+    // a finishes first and c is swapped into its slot.
+    easing::tween(easer, &a, 1.f, 10);
+    easing::tween(easer, &b, 1.f, 100);
+    easing::tween(easer, &c, 1.f, 100);
+    easer.step(10);
+    assert(easer.tweens.size() == 2);
+
+    // Retargets c where it now is, rather than adding a second tween.
+    easing::tween(easer, &c, -1.f, 10);
+    assert(easer.tweens.size() == 2);
+
+    assert(easer.tweens.cancel(&b));
+    easer.step(10);
+    assert(easer.tweens.size() == 0);
+    assert(a == 1.f);
+    assert(near(b, 0.1f));
+    assert(c == -1.f);
+}
+
+void test_many_tweens_finish_together()
+{
+    easing::Easer      easer;
+    std::vector<float> values(5000, 0.f);
+
+    easer.tweens.reserve(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        easing::tween(easer, &values[i], float(i), 16 * (1 + (i % 4)), easing::Curve::QUAD_OUT);
+    }
+
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        easer.step(16);
+    }
+
+    assert(easer.tweens.size() == 0);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        assert(values[i] == float(i));
+    }
+}
+
+// Once reserved, starting, retargeting, cancelling and finishing tweens do
+// not allocate, so tweens can run inside a sim tick.
+void test_reserved_tweens_do_not_allocate()
+{
+    easing::Easer      easer;
+    std::vector<float> values(256, 0.f);
+    easer.tweens.reserve(values.size());
+
+    auto const start = debug::thread_allocations();
+
+    for (int round = 0; round < 4; ++round)
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            easing::tween(easer, &values[i], float(round), 16 * (1 + (i % 3)));
+        }
+        for (std::size_t i = 0; i < values.size(); i += 5)
+        {
+            assert(easer.tweens.cancel(&values[i]));
+        }
+        easer.step(16);
+        easer.step(16);
+    }
+    easer.step(16);
+
+    assert(debug::allocations_since(start).count == 0);
+    assert(easer.tweens.size() == 0);
+}
+
+// Cancelling after many swap removes still finds every target, and only
+// those that are tweening.
+void test_cancel_after_churn()
+{
+    easing::Easer      easer;
+    std::vector<float> values(1000, 0.f);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        easing::tween(easer, &values[i], 1.f, (i % 2) ? 10 : 1000);
+    }
+    easer.step(10);
+    assert(easer.tweens.size() == values.size() / 2);
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        assert(easer.tweens.cancel(&values[i]) == ((i % 2) == 0));
+    }
+    assert(easer.tweens.size() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_TWEEN
+int main()
+{
+    test_linear_tween_reaches_target();
+    test_curves_start_and_end_on_their_endpoints();
+    test_lookup_matches_curve();
+    test_shake_returns_to_start();
+    test_retarget_replaces_running_tween();
+    test_vec2_tween_and_cancel();
+    test_retarget_after_swap_remove();
+    test_many_tweens_finish_together();
+    test_reserved_tweens_do_not_allocate();
+    test_cancel_after_churn();
+    printf("Test tween complete.\n");
+}
+#endif